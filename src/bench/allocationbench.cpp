@@ -0,0 +1,113 @@
+/*
+ * Counts heap allocations and measures the time of one b_spline evaluation,
+ * once with the dense vec3 path used by math::b_spline and once with the
+ * dynamic math::vec using the same basis expression, as operators and as one linearCombination.
+ *
+ * build/Makefile: make bench
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "../math/vector.h"
+#include "../math/splines/bspline.h"
+#include "../math/splines/bezier.h"
+
+static long long allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    allocationCount++;
+    if(void* out = std::malloc(size)) return out;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+// the uniform cubic b-spline basis, written against the dynamic vec
+static math::vec dynamicBSpline(const math::vec& p1, const math::vec& p2, const math::vec& p3, const math::vec& p4, double t) {
+    return (1  * (p1 + 4 * p2 + p3)/6.0 + 
+            t   * (-3 * p1 + 3 * p3)/6.0 +
+            t*t  * (3 * p1 - 6 * p2 + 3 * p3)/6.0 + 
+            t*t*t * (-p1 + 3 * p2 - 3 * p3 + p4)/6.0);
+}
+
+// the same basis with the weights of the four points summed first, then one fused pass
+static math::vec fusedBSpline(const math::vec& p1, const math::vec& p2, const math::vec& p3, const math::vec& p4, double t) {
+    double weights[4]{};
+    for(int i = 0; i < 4; i++) {
+        for(int power = 3; power >= 0; power--) weights[i] = weights[i] * t + math::bspline_basis::matrix[power][i];
+    }
+    return math::vec::linearCombination({ weights[0], weights[1], weights[2], weights[3] }, { &p1, &p2, &p3, &p4 });
+}
+
+template<typename Function>
+static void measure(const char* name, int iterations, Function function) {
+    long long allocationsBefore = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+
+    double checksum = 0;
+    for(int i = 0; i < iterations; i++) checksum += function(i);
+
+    auto end = std::chrono::steady_clock::now();
+    double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::cout << name << ": "
+              << (double) (allocationCount - allocationsBefore) / iterations << " allocations/call, "
+              << nanoseconds / iterations << " ns/call"
+              << " (checksum " << checksum << ")" << std::endl;
+}
+
+int main() {
+    const int iterations = 200000;
+
+    math::b_spline path{{ { 2, 4, 0 }, { 7, 0, 20 }, { 12, -4, 5 }, { -12, 0, 17 }, { -20, 2, 5 }, { 3, 1, -6 } }};
+    double maxU = path.getSegmentCount();
+
+    measure("b_spline::get (vec3)", iterations, [&](int i) {
+        return path.get(maxU * i / iterations).x;
+    });
+
+    math::spline_stepper walker{ path.stepper(0, maxU / iterations) };
+    measure("spline_stepper::next (vec3)", iterations, [&](int i) {
+        return walker.next().getPosition().x;
+    });
+
+    std::vector<math::vec3> designerCurve{};
+    for(int i = 0; i < 24; i++) designerCurve.push_back(math::vec3{ std::cos(i * 0.7) * i, (double) (i % 5), std::sin(i * 0.7) * i });
+    math::bezier longBezier{ designerCurve };
+
+    measure("bezier::get, degree 23 (vec3)", iterations, [&](int i) {
+        return longBezier.getPositionByPercentage((double) i / iterations).x;
+    });
+
+    math::vec p1{ math::vec::vec3d(2, 4, 0) };
+    math::vec p2{ math::vec::vec3d(7, 0, 20) };
+    math::vec p3{ math::vec::vec3d(12, -4, 5) };
+    math::vec p4{ math::vec::vec3d(-12, 0, 17) };
+
+    measure("b-spline basis (math::vec)", iterations, [&](int i) {
+        return dynamicBSpline(p1, p2, p3, p4, (double) i / iterations).get(0);
+    });
+
+    measure("b-spline basis, linearCombination (math::vec)", iterations, [&](int i) {
+        return fusedBSpline(p1, p2, p3, p4, (double) i / iterations).get(0);
+    });
+
+    measure("p1 + 4 * p2 + p3 (math::vec)", iterations, [&](int i) {
+        return (p1 + 4 * p2 + p3).get(0);
+    });
+
+    measure("addScaled (math::vec)", iterations, [&](int i) {
+        math::vec out{ p1 };
+        return out.addScaled(p2, 4).addScaled(p3, 1).get(0);
+    });
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * Compares the lu based inverse with the cofactor (adjoint) path for
+ * n = 3, 10 and 100 and times many solves against one factorization.
+ * The cofactor path is a copy of what matrix::inverse did before the lu decomposition, with det
+ * as a cofactor expansion (the old det() only handled 3x3). It is O(n!), so n = 100 is skipped.
+ *
+ * build/Makefile: make bench
+ */
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include "../math/matrix.h"
+#include "../math/vector.h"
+#include "../math/lu.h"
+
+static math::matrix randomMatrix(int size, std::mt19937& random) {
+    std::uniform_real_distribution<double> distribution{ -1, 1 };
+
+    math::matrix out{ size, size };
+    for(int r = 0; r < size; r++) {
+        for(int c = 0; c < size; c++) out.set(r, c, distribution(random));
+        out.set(r, r, out.get(r, r) + size); // diagonally dominant, so well conditioned
+    }
+    return out;
+}
+
+// largest absolute entry of m * inverse - identity
+static double inverseError(const math::matrix& m, const math::matrix& inverse) {
+    math::matrix product{ m * inverse };
+
+    double out = 0;
+    for(int r = 0; r < m.getAmountOfRows(); r++) {
+        for(int c = 0; c < m.getAmountOfColumns(); c++) {
+            out = std::max(out, std::abs(product.get(r, c) - (r == c? 1: 0)));
+        }
+    }
+    return out;
+}
+
+// the old cofactor path, every cofactor is the det of a submatrix
+static double cofactorDet(const math::matrix& m) {
+    int size = m.getAmountOfRows();
+    if(size == 1) return m.get(0, 0);
+    if(size == 2) return m.get(0, 0) * m.get(1, 1) - m.get(0, 1) * m.get(1, 0);
+
+    double out = 0;
+    for(int c = 0; c < size; c++) out += (c % 2 == 0? 1: -1) * m.get(0, c) * cofactorDet(m.submatrix({ 0 }, { c }));
+    return out;
+}
+
+static math::matrix cofactorInverse(const math::matrix& m) {
+    int size = m.getAmountOfRows();
+
+    math::matrix out{ size, size };
+    for(int r = 0; r < size; r++) {
+        for(int c = 0; c < size; c++) out.set(c, r, ((r + c) % 2 == 0? 1: -1) * cofactorDet(m.submatrix({ r }, { c })));
+    }
+    out /= cofactorDet(m);
+    return out;
+}
+
+template<typename Function>
+static double microseconds(int iterations, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < iterations; i++) function();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+int main() {
+    std::mt19937 random{ 42 };
+
+    for(int size: { 3, 10, 100 }) {
+        math::matrix m{ randomMatrix(size, random) };
+        int iterations = size == 3? 20000: size == 10? 200: 5;
+
+        std::cout << "n = " << size << std::endl;
+        if(size <= 10) {
+            math::matrix cofactor{ size, size };
+            double cofactorTime = microseconds(size == 3? iterations: 1, [&]() {
+                cofactor = cofactorInverse(m);
+            });
+            std::cout << "  cofactor inverse: " << cofactorTime << " us, error " << inverseError(m, cofactor) << std::endl;
+        }
+        else {
+            std::cout << "  cofactor inverse: skipped, O(n!)" << std::endl;
+        }
+
+        math::matrix luInverse{ size, size };
+        double luTime = microseconds(iterations, [&]() {
+            luInverse = m.inverse();
+        });
+        std::cout << "  lu inverse:       " << luTime << " us, error " << inverseError(m, luInverse) << std::endl;
+    }
+
+    // one factorization, many right hand sides
+    int size = 300;
+    int rightHandSides = 100;
+    math::matrix m{ randomMatrix(size, random) };
+    math::vec b{ size };
+    for(int i = 0; i < size; i++) b.set(i, i % 7);
+
+    math::lu_decomposition factorization{ m.lu() };
+    double factorizeTime = microseconds(1, [&]() { factorization = m.lu(); });
+    double solveTime = microseconds(rightHandSides, [&]() { factorization.solve(b); });
+
+    std::cout << "n = " << size << std::endl
+              << "  factorize: " << factorizeTime << " us" << std::endl
+              << "  solve:     " << solveTime << " us per right hand side" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * Measures how far the float splines drift from the double ones on a set of tracks:
+ * the main.cpp track plus seeded random tracks of growing length and size.
+ * Errors are relative to the size (bounding box diagonal) of the track.
+ *
+ * build/Makefile: make bench
+ */
+#include <iostream>
+#include <random>
+
+#include "../math/vec3.h"
+#include "../math/splines/catmullromspline.h"
+#include "../math/splines/bspline.h"
+
+struct precision_error {
+    double position = 0;
+    double angle = 0;
+};
+
+static double trackSize(const std::vector<math::vec3>& points) {
+    math::vec3 min{ points.at(0) };
+    math::vec3 max{ points.at(0) };
+    for(const math::vec3& p: points) {
+        for(int i = 0; i < 3; i++) {
+            min.set(i, std::min(min.get(i), p.get(i)));
+            max.set(i, std::max(max.get(i), p.get(i)));
+        }
+    }
+    return min.distanceTo(max);
+}
+
+template<template<typename> class Spline>
+static precision_error compare(const std::vector<math::vec3>& points, double sampleRate) {
+    Spline<double> doubleSpline{ points };
+    Spline<float> floatSpline{ math::convertPoints<float>(points) };
+    double size = trackSize(points);
+
+    precision_error out{};
+    for(double u = 0; u <= doubleSpline.getSegmentCount(); u += sampleRate) {
+        oriented_point exact{ doubleSpline.getOrientedPoint(u) };
+        oriented_pointf approximation{ floatSpline.getOrientedPoint(u) };
+
+        out.position = std::max(out.position, exact.position.distanceTo(math::vec3{ approximation.position }) / size);
+        for(int axis = 0; axis < 3; axis++) {
+            math::vec3 a{ exact.rotation.getColumn(axis) };
+            math::vec3 b{ approximation.rotation.getColumn(axis) };
+            out.angle = std::max(out.angle, std::atan2(a.cross(b).length(), a.dot(b)));
+        }
+    }
+    return out;
+}
+
+static void report(const char* name, const precision_error& error) {
+    std::cout << "  " << name << ": position " << error.position << " (relative), frame " << error.angle << " rad" << std::endl;
+}
+
+int main() {
+    std::vector<std::vector<math::vec3>> tracks{
+        { { 2, 4, 0 }, { 7, 0, 20 }, { 12, -4, 5 }, { -12, 0, 17 }, { -20, 2, 5 } }
+    };
+
+    std::mt19937 random{ 7 };
+    for(int length: { 10, 100, 1000 }) {
+        double extent = length * 10;
+        std::uniform_real_distribution<double> horizontal{ -extent, extent };
+        std::uniform_real_distribution<double> vertical{ -extent / 10, extent / 10 };
+
+        std::vector<math::vec3> track{};
+        for(int i = 0; i < length; i++) track.push_back(math::vec3{ horizontal(random), vertical(random), horizontal(random) });
+        tracks.push_back(track);
+    }
+
+    precision_error worst{};
+    for(const std::vector<math::vec3>& track: tracks) {
+        std::cout << track.size() << " control points" << std::endl;
+
+        precision_error catmullrom{ compare<math::basic_catmullrom_spline>(track, 0.02) };
+        precision_error bspline{ compare<math::basic_b_spline>(track, 0.02) };
+        report("catmullrom_spline", catmullrom);
+        report("b_spline", bspline);
+
+        worst.position = std::max({ worst.position, catmullrom.position, bspline.position });
+        worst.angle = std::max({ worst.angle, catmullrom.angle, bspline.angle });
+    }
+
+    std::cout << "worst" << std::endl;
+    report("all", worst);
+    return 0;
+}
@@ -0,0 +1,234 @@
+#ifndef EXTRUDE_H
+#define EXTRUDE_H
+
+#include <vector>
+#include <algorithm>
+
+#include "raylib.h"
+#include "point.h"
+#include "meshbuilder.h"
+#include "parallel.h"
+#include "math/vec3.h"
+
+// the cross section of the track, in the local coordinates of an edgeloop frame
+inline std::vector<Vector3> GetOutline() {
+    std::vector<Vector3> outline{};
+
+    float scale = 0.25f;
+    outline.push_back(Vector3{-4 * scale, -2 * scale});
+    outline.push_back(Vector3{-3 * scale, -2 * scale});
+    outline.push_back(Vector3{-2 * scale, -1 * scale});
+    outline.push_back(Vector3{2 * scale, -1 * scale});
+    outline.push_back(Vector3{3 * scale, -2 * scale});
+    outline.push_back(Vector3{4 * scale, -2 * scale});
+
+    return outline;
+}
+
+inline int extrudedVertexCount(int outlineVertices, int edgeLoops) {
+    return outlineVertices * edgeLoops;
+}
+
+inline int extrudedTriangleCount(int outlineVertices, int edgeLoops) {
+    return std::max(0, (outlineVertices - 1) * (edgeLoops - 1) * 2);
+}
+
+// where extrudeVertices writes, every buffer but vertices is optional (see vertex_attributes)
+struct extrusion_buffers {
+    float* vertices = nullptr;
+    float* normals = nullptr;
+    float* texcoords = nullptr;
+    float* tangents = nullptr;
+};
+
+/*
+ * The vertices of a single edgeloop from its frame, extrudeVertices runs it for every loop.
+ * Writers that stream the track loop by loop (trackexport.h) use it directly.
+ *
+ * The attributes come from the frame that places the vertices, the spline is not evaluated again:
+ *  normal   the 2d normal of the outline (average of its two edges) rotated by the frame
+ *  texcoord u is given per loop (the distance along the track), v is the distance along the outline
+ *  tangent  the direction of the track made perpendicular to the normal, w = -1 where the outline runs mirrored
+ */
+template<typename T>
+class edgeloop_extruder {
+public:
+    using vector = math::basic_vec3<T>;
+
+    edgeloop_extruder(const std::vector<Vector3>& outline) {
+        for(const Vector3& v: outline) outlineInLocalCoordinates.push_back(vector{ v });
+
+        // normals and distances along the outline, in the plane of the edgeloop. The normals are on the
+        // side the triangles of extrudeIndices face (counter clockwise, right of the outline direction)
+        int vertsInShape = outline.size();
+        outlineNormals.resize(vertsInShape);
+        outlineDistances.resize(vertsInShape);
+        for(int vi = 0; vi + 1 < vertsInShape; vi++) {
+            vector edge{ outlineInLocalCoordinates[vi + 1] - outlineInLocalCoordinates[vi] };
+            vector normal{ vector{ edge.y, -edge.x, 0 }.normalize() };
+            outlineNormals[vi] += normal;
+            outlineNormals[vi + 1] += normal;
+            outlineDistances[vi + 1] = outlineDistances[vi] + (float) edge.length();
+        }
+        for(vector& normal: outlineNormals) normal.normalize();
+    }
+
+    int getVertexCount() const {
+        return outlineInLocalCoordinates.size();
+    }
+
+    // writes vertex vi of the loop to index first + vi of the buffers in out
+    void extrude(const basic_oriented_pose<T>& frame, float u, int first, const extrusion_buffers& out) const {
+        basic_oriented_point<T> p{ frame.toOrientedPoint() };
+        vector forward{ p.rotation.getColumn(2) };
+
+        for(int vi = 0; vi < getVertexCount(); vi++) {
+            int index = first + vi;
+            meshbuilder::writeVertex(out.vertices, index, p.localToWorld(outlineInLocalCoordinates[vi]).toVector3());
+
+            vector normal{ p.rotation * outlineNormals[vi] };
+            if(out.normals) meshbuilder::writeNormal(out.normals, index, normal.toVector3());
+            if(out.texcoords) meshbuilder::writeTexcoord(out.texcoords, index, Vector2{ u, outlineDistances[vi] });
+
+            if(out.tangents) {
+                vector tangent{ (forward - normal * normal.dot(forward)).normalize() };
+                vector bitangent{ p.rotation * vector{ -outlineNormals[vi].y, outlineNormals[vi].x, 0 } };
+                float handedness = normal.cross(tangent).dot(bitangent) < 0? -1.0f: 1.0f;
+                meshbuilder::writeTangent(out.tangents, index, Vector4{ (float) tangent.x, (float) tangent.y, (float) tangent.z, handedness });
+            }
+        }
+    }
+
+private:
+    std::vector<vector> outlineInLocalCoordinates{};
+    std::vector<vector> outlineNormals{};
+    std::vector<float> outlineDistances{};
+};
+
+// texcoord u of every edgeloop: the chord length between the loops, counted from startDistance
+template<typename T>
+std::vector<float> edgeLoopDistances(const std::vector<basic_oriented_pose<T>>& edgeLoopFrames, float startDistance = 0) {
+    std::vector<float> distances(edgeLoopFrames.size(), startDistance);
+    for(int i = 1; i < (int) distances.size(); i++) {
+        distances[i] = distances[i - 1] + (float) (edgeLoopFrames[i].position - edgeLoopFrames[i - 1].position).length();
+    }
+    return distances;
+}
+
+/*
+ *  +-----+-----+   Edgeloop 1, 3 vertices (+)
+ *  i     i     i   \
+ *  i     i     i    |
+ *  i     i     i     > Segment 1
+ *  i     i     i    |
+ *  i     i     i   /
+ *  +-----+-----+   Edgeloop 2
+ *
+ * For each segment we have (vertices in outline/edgeloop -1) quads
+ * Each quads needs two vertices
+ * There is one edgeloop per entry of edgeLoopFrames
+ *
+ * Every vertex of an edgeloop is computed once, vertex vi of loop i goes to index i * outline.size() + vi
+ * of out (see extrudedVertexCount). extrudeIndices connects them, no gpu or window needed.
+ * loopDistances holds texcoord u of every loop, it is only read when out has texcoords.
+ */
+template<typename T>
+void extrudeVertices(const std::vector<Vector3>& outline, const std::vector<basic_oriented_pose<T>>& edgeLoopFrames, const std::vector<float>& loopDistances, const extrusion_buffers& out, int threads = parallel::threadCount()) {
+    int vertsInShape = outline.size();
+    int edgeLoops = edgeLoopFrames.size();
+    edgeloop_extruder<T> extruder{ outline };
+
+    //edgeloops only depend on their own frames, so they are split across threads
+    parallel::forChunks(edgeLoops, [&](int first, int last) {
+        for(int i = first; i < last; i++) extruder.extrude(edgeLoopFrames[i], out.texcoords? loopDistances[i]: 0, i * vertsInShape, out);
+    }, 1024, threads);
+}
+
+// texcoord u is the chord length from the first edgeloop (see edgeLoopDistances)
+template<typename T>
+void extrudeVertices(const std::vector<Vector3>& outline, const std::vector<basic_oriented_pose<T>>& edgeLoopFrames, const extrusion_buffers& out, int threads = parallel::threadCount()) {
+    extrudeVertices(outline, edgeLoopFrames, out.texcoords? edgeLoopDistances(edgeLoopFrames): std::vector<float>{}, out, threads);
+}
+
+/*
+ * The two triangles of every quad between edgeloop loop and loop + 1, as function(i1, i2, i3) with
+ * indices into the whole track (see extrudeVertices), counter clockwise seen from the outline normals.
+ * Everything that connects edgeloops goes through here, so all outputs have the same triangles in the same order.
+ */
+template<typename Function>
+void forEachLoopTriangle(int vertsInShape, int loop, Function function) {
+    int startIndexFirstLoop = vertsInShape * loop;
+    int startIndexSecondLoop = vertsInShape + startIndexFirstLoop;
+
+    for(int vi = 0; vi < vertsInShape - 1; vi++) {
+        int v1_loop1 = startIndexFirstLoop + vi;
+        int v2_loop1 = startIndexFirstLoop + vi + 1;
+        int v1_loop2 = startIndexSecondLoop + vi;
+        int v2_loop2 = startIndexSecondLoop + vi + 1;
+
+        function(v1_loop1, v2_loop1, v1_loop2);
+        function(v1_loop2, v2_loop1, v2_loop2);
+    }
+}
+
+// the triangles of all edgeloops, 3 indices each (see extrudedTriangleCount)
+template<typename Index>
+void extrudeIndices(int vertsInShape, int edgeLoops, Index* out, int threads = parallel::threadCount()) {
+    parallel::forChunks(edgeLoops - 1, [&](int first, int last) {
+        for(int loop = first; loop < last; loop++) {
+            int triangle = (vertsInShape - 1) * 2 * loop;
+            forEachLoopTriangle(vertsInShape, loop, [&](int i1, int i2, int i3) { meshbuilder::writeIndices(out, triangle++, i1, i2, i3); });
+        }
+    }, 1024, threads);
+}
+
+/*
+ * extrudeVertices and extrudeIndices into a mesh uploaded to the gpu, with normals and texcoords by default.
+ * Indexed while the vertices fit raylib's 16 bit indices, which uploads about 6 times fewer vertices,
+ * otherwise triangle soup. loopDistances is texcoord u of every edgeloop, as in extrudeVertices.
+ */
+template<typename T>
+Mesh extrude(const std::vector<Vector3>& outline, const std::vector<basic_oriented_pose<T>>& edgeLoopFrames, const std::vector<float>& loopDistances, vertex_attributes attributes = { true, true, false }) {
+    int vertsInShape = outline.size();
+    int edgeLoops = edgeLoopFrames.size();
+    int vertexCount = extrudedVertexCount(vertsInShape, edgeLoops);
+    int triangles = extrudedTriangleCount(vertsInShape, edgeLoops);
+
+    if(vertexCount <= meshbuilder::maxIndexedVertices) {
+        meshbuilder builder{ vertexCount, triangles, attributes };
+        extrudeVertices(outline, edgeLoopFrames, loopDistances, extrusion_buffers{ builder.getVertices(), builder.getNormals(), builder.getTexcoords(), builder.getTangents() });
+        extrudeIndices(vertsInShape, edgeLoops, builder.getIndices());
+        return builder.build();
+    }
+
+    std::vector<float> vertices(vertexCount * 3);
+    std::vector<float> normals(attributes.normals? vertexCount * 3: 0);
+    std::vector<float> texcoords(attributes.texcoords? vertexCount * 2: 0);
+    std::vector<float> tangents(attributes.tangents? vertexCount * 4: 0);
+    std::vector<int> indices(triangles * 3);
+    extrudeVertices(outline, edgeLoopFrames, loopDistances, extrusion_buffers{ vertices.data(),
+        attributes.normals? normals.data(): nullptr, attributes.texcoords? texcoords.data(): nullptr, attributes.tangents? tangents.data(): nullptr });
+    extrudeIndices(vertsInShape, edgeLoops, indices.data());
+
+    // copies the attribute of every corner, size floats per vertex
+    meshbuilder builder{ triangles, attributes };
+    auto expand = [&](const std::vector<float>& source, float* target, int size) {
+        if(!target) return;
+        parallel::forChunks(triangles * 3, [&](int first, int last) {
+            for(int corner = first; corner < last; corner++) std::copy_n(source.data() + indices[corner] * size, size, target + corner * size);
+        });
+    };
+    expand(vertices, builder.getVertices(), 3);
+    expand(normals, builder.getNormals(), 3);
+    expand(texcoords, builder.getTexcoords(), 2);
+    expand(tangents, builder.getTangents(), 4);
+    return builder.build();
+}
+
+// texcoord u is the chord length from the first edgeloop
+template<typename T>
+Mesh extrude(const std::vector<Vector3>& outline, const std::vector<basic_oriented_pose<T>>& edgeLoopFrames, vertex_attributes attributes = { true, true, false }) {
+    return extrude(outline, edgeLoopFrames, attributes.texcoords? edgeLoopDistances(edgeLoopFrames): std::vector<float>{}, attributes);
+}
+
+#endif
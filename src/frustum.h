@@ -0,0 +1,85 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <cmath>
+
+#include "raylib.h"
+#include "math/vec3.h"
+
+/*
+ * The view volume of a perspective raylib Camera as 6 planes, for culling on the cpu before anything is drawn.
+ * near and far default to the clip distances of rlgl (RL_CULL_DISTANCE_NEAR / FAR), aspect is width / height
+ * of the screen. The tests are conservative: a sphere or box close to a corner of the frustum can pass
+ * without being visible, something visible never fails.
+ */
+class frustum {
+public:
+    frustum(const Camera& camera, float aspect, float nearDistance = 0.01f, float farDistance = 1000.0f) {
+        math::vec3f position{ camera.position };
+        math::vec3f forward{ (math::vec3f{ camera.target } - position).normalize() };
+        math::vec3f right{ forward.cross(math::vec3f{ camera.up }).normalize() };
+        math::vec3f up{ right.cross(forward) };
+
+        float halfHeight = std::tan(camera.fovy * 0.5f * DEG2RAD);
+        float halfWidth = halfHeight * aspect;
+
+        planes[0] = plane::through(position + forward * nearDistance, forward);
+        planes[1] = plane::through(position + forward * farDistance, -forward);
+
+        // the side planes contain the camera position and one edge of the screen
+        math::vec3f left{ forward - right * halfWidth };
+        math::vec3f rightEdge{ forward + right * halfWidth };
+        math::vec3f bottom{ forward - up * halfHeight };
+        math::vec3f top{ forward + up * halfHeight };
+        planes[2] = plane::through(position, inside(up.cross(left), forward));
+        planes[3] = plane::through(position, inside(up.cross(rightEdge), forward));
+        planes[4] = plane::through(position, inside(right.cross(bottom), forward));
+        planes[5] = plane::through(position, inside(right.cross(top), forward));
+    }
+
+    bool containsSphere(Vector3 center, float radius) const {
+        math::vec3f c{ center };
+        for(const plane& p: planes) {
+            if(p.distanceTo(c) < -radius) return false;
+        }
+        return true;
+    }
+
+    // per plane only the corner of the box farthest inside is tested
+    bool intersectsBox(const BoundingBox& box) const {
+        for(const plane& p: planes) {
+            math::vec3f corner{
+                p.normal.x >= 0? box.max.x: box.min.x,
+                p.normal.y >= 0? box.max.y: box.min.y,
+                p.normal.z >= 0? box.max.z: box.min.z
+            };
+            if(p.distanceTo(corner) < 0) return false;
+        }
+        return true;
+    }
+
+private:
+    // points with normal.dot(p) + offset >= 0 are inside
+    struct plane {
+        math::vec3f normal{};
+        float offset = 0;
+
+        static plane through(const math::vec3f& point, const math::vec3f& inNormal) {
+            math::vec3f normal{ inNormal.normalize() };
+            return plane{ normal, -normal.dot(point) };
+        }
+
+        float distanceTo(const math::vec3f& point) const {
+            return normal.dot(point) + offset;
+        }
+    };
+
+    plane planes[6];
+
+    // flips normal to the side of the view direction
+    static math::vec3f inside(const math::vec3f& normal, const math::vec3f& forward) {
+        return normal.dot(forward) < 0? -normal: normal;
+    }
+};
+
+#endif
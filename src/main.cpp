@@ -5,38 +5,75 @@
 #include "raylib.h"
 
 #include "point.h"
-#include "meshbuilder.h"
-#include "math/vector.h"
+#include "extrude.h"
+#include "trackchunks.h"
+#include "frustum.h"
+#include "trackcache.h"
+#include "math/vec3.h"
 #include "math/splines/spline.h"
 #include "math/splines/catmullromspline.h"
-
-std::vector<Vector3> GetOutline();
-Mesh extrude(const std::vector<Vector3>& outline, const math::spline& s, double sampleRate);
+#include "math/splines/arclength.h"
+#include "math/splines/frametable.h"
+#include "math/splines/tessellation.h"
 
 struct car {
     double currentU{};
-    double uSpeed{};
+    double uSpeed{};                //average speed, converted to a constant distance per frame
     double verticalOffset{};
     double offsetGoal{};
     Color color{};
+    double currentDistance{};
 };
 
 int main(void) {
     //ShowWindow(GetConsoleWindow(), SW_HIDE);
 
-    math::catmullrom_spline extrusionPath{
-        { math::vec::vec3d(2, 4, 0), math::vec::vec3d(7, 0, 20), math::vec::vec3d(12, -4, 5),
-            math::vec::vec3d(-12, 0, 17), math::vec::vec3d(-20, 2, 5)
-            }
+    std::vector<math::vec3> trackPoints{
+        math::vec3{ 2, 4, 0 }, math::vec3{ 7, 0, 20 }, math::vec3{ 12, -4, 5 },
+        math::vec3{ -12, 0, 17 }, math::vec3{ -20, 2, 5 }
     };
 
+    math::catmullrom_spline extrusionPath{ trackPoints };                                   //double precision for the simulation
+
     const int screenWidth = 1200;
     const int screenHeight = 800;
 
     InitWindow(screenWidth, screenHeight, "SplineCoaster");
     SetTargetFPS(60);
 
-    Model model{ LoadModelFromMesh( extrude(GetOutline(), extrusionPath, 0.02f) ) };
+    //rotation minimizing frames, built once
+    math::frame_table extrusionFrames{ extrusionPath };
+
+    //the track mesh depends on nothing else, a cache file with the same key skips the spline and tessellation work
+    const std::vector<Vector3> outline{ GetOutline() };
+    const int renderSamplesPerSegment = 50;
+    const math::tessellation_tolerance tolerance{};
+    const float chunkLength = 10.0f;
+    const int lodLevels = 3;
+    const float lodDistance = 20.0f;
+
+    std::uint64_t trackKey{ cache_key{}.add(std::string{ "catmullrom_splinef" }).add(trackPoints).add(outline)
+        .addValue(renderSamplesPerSegment).addValue(tolerance.maxChordDeviation).addValue(tolerance.maxFrameAngle)
+        .addValue(tolerance.minSamplesPerSegment).addValue(tolerance.maxDepth).addValue(chunkLength).addValue(lodLevels).get() };
+
+    std::vector<track_chunk> trackChunks{};
+    if(loadTrackCache(trackCachePath(trackKey), trackKey, trackChunks)) {
+        TraceLog(LOG_INFO, "TRACK: %i chunks loaded from %s", (int) trackChunks.size(), trackCachePath(trackKey).c_str());
+    } else {
+        math::catmullrom_splinef renderPath{ math::convertPoints<float>(trackPoints) };    //float precision for tessellation
+        math::frame_tablef renderFrames{ renderPath, renderSamplesPerSegment };
+
+        //more edgeloops in turns than on straights, math::tessellateUniform gives one every 0.02 u
+        std::vector<oriented_posef> edgeLoops{};
+        math::tessellation_report tessellation{ math::tessellateAdaptive(renderFrames, tolerance, edgeLoops) };
+
+        //pieces of about 10 units with their own bounds and 3 levels of detail, only the ones in view are drawn
+        trackChunks = extrudeChunks(outline, edgeLoops, chunkLength, lodLevels);
+        if(!saveTrackCache(trackCachePath(trackKey), trackKey, trackChunks)) TraceLog(LOG_WARNING, "TRACK: could not write %s", trackCachePath(trackKey).c_str());
+
+        TraceLog(LOG_INFO, "TRACK: %i edgeloops in %i chunks, chord deviation %f, frame angle %f rad",
+            tessellation.edgeLoops, (int) trackChunks.size(), tessellation.chordDeviation, tessellation.frameAngle);
+    }
     Camera camera = { { 5.0f, 5.0f, 5.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, 45.0f, 0 };
 
     std::vector<car> cars{
@@ -49,6 +86,14 @@ int main(void) {
         { 0.7, 0.02, -0.16, -0.16, VIOLET}
     };
 
+    //cars move at constant speed along the track instead of constant uSpeed
+    math::arclength_table extrusionPathLength{ extrusionPath };
+    double lengthPerSegment = extrusionPathLength.getLength() / extrusionPath.getSegmentCount();
+    for(car& c: cars) c.currentDistance = extrusionPathLength.distanceAtU(c.currentU);
+
+    //looked up once per frame for all cars
+    std::vector<oriented_point> carFrames{};
+
     int currentlyLookedAtCarIndex = 4;
     int frameCount = 0;
     while (!WindowShouldClose()) {   // Detect window close button or ESC key
@@ -62,22 +107,25 @@ int main(void) {
 
         //update cars
         for(car& c: cars) {
-            c.currentU += c.uSpeed;
-            if(c.currentU > extrusionPath.getSegmentCount()) c.currentU -= extrusionPath.getSegmentCount();
+            c.currentDistance += c.uSpeed * lengthPerSegment;
+            if(c.currentDistance > extrusionPathLength.getLength()) c.currentDistance -= extrusionPathLength.getLength();
+            c.currentU = extrusionPathLength.uAtDistance(c.currentDistance);
 
             c.verticalOffset += (c.offsetGoal - c.verticalOffset) / GetRandomValue(10, 25);
             if(std::abs(c.verticalOffset - c.offsetGoal) < 0.01) c.offsetGoal = (GetRandomValue(0, 40) - 20) / 20.0;
         }
+
+        carFrames.clear();
+        for(const car& c: cars) carFrames.push_back(extrusionFrames.getOrientedPoint(c.currentU));
         
         {   //update camera position
-            const car& currentlyLookedAtCar{ cars.at(currentlyLookedAtCarIndex) };
-            oriented_point carPosition{ extrusionPath.getOrientedPoint(currentlyLookedAtCar.currentU) };
+            const oriented_point& carPosition{ carFrames.at(currentlyLookedAtCarIndex) };
             
-            math::vec oldCameraPosition{ math::vec::vec3d(camera.position.x, camera.position.y, camera.position.z) };
-            math::vec newCameraPositionHard{ carPosition.localToWorld(math::vec::vec3d(xOffset, -3, -6)) };
-            newCameraPositionHard += math::vec::vec3d(0, std::abs(extrusionPath.getDerivate(currentlyLookedAtCar.currentU).get(1)), 0) * 5; //take heightchange of track in account
+            math::vec3 oldCameraPosition{ camera.position.x, camera.position.y, camera.position.z };
+            math::vec3 newCameraPositionHard{ carPosition.localToWorld(math::vec3{ xOffset, -3, -6 }) };
+            newCameraPositionHard += math::vec3{ 0, std::abs(carPosition.rotation.getColumn(2).y), 0 } * 5; //take heightchange of track in account
 
-            math::vec newCameraPositionSoft{ 0.2 * newCameraPositionHard + 0.8 * oldCameraPosition }; //smoother blend between positions
+            math::vec3 newCameraPositionSoft{ math::lerp(oldCameraPosition, 0.2, newCameraPositionHard) }; //smoother blend between positions
 
             camera.position = newCameraPositionSoft.toVector3();
             camera.target = carPosition.position.toVector3();
@@ -91,21 +139,23 @@ int main(void) {
 
             BeginMode3D(camera);
 
-              DrawModel(model, Vector3{ 0.0f, 0.0f, 0.0f }, 1.0f, PURPLE);
-              DrawModelWires(model, Vector3{ 0.0f, 0.0f, 0.0f }, 1.0f, RED);
+              chunk_draw_stats chunkStats{ drawChunks(trackChunks, frustum{ camera, (float) screenWidth / screenHeight }, camera.position, lodDistance, PURPLE, RED) };
 
-              for(car& c: cars) {
-                oriented_point positionOnPath{ extrusionPath.getOrientedPoint(c.currentU) };
+              for(int i = 0; i < (int) cars.size(); i++) {
+                const car& c{ cars.at(i) };
+                const oriented_point& positionOnPath{ carFrames.at(i) };
 
-                math::vec carPos{ positionOnPath.position };
-                carPos += math::vec::vec3d(0, 0.4, 0);
-                carPos += positionOnPath.worldToLocalDirection(math::vec::vec3d(c.verticalOffset, 0, 0));
+                math::vec3 carPos{ positionOnPath.position };
+                carPos += math::vec3{ 0, 0.4, 0 };
+                carPos += positionOnPath.localToWorldDirection(math::vec3{ c.verticalOffset, 0, 0 });
 
                 DrawCube(carPos.toVector3(), 0.6f, 0.6f, 0.6f, c.color);
               }
 
             EndMode3D();
 
+            DrawText(TextFormat("chunks drawn: %i, culled: %i, triangles: %i", chunkStats.drawn, chunkStats.culled, chunkStats.triangles), 10, 10, 20, DARKGRAY);
+
         EndDrawing();
         frameCount++;
     }
@@ -113,72 +163,3 @@ int main(void) {
     CloseWindow();
     return 0;
 }
-
-std::vector<Vector3> GetOutline() {
-    std::vector<Vector3> outline{};
-
-    float scale = 0.25f;
-    outline.push_back(Vector3{-4 * scale, -2 * scale});
-    outline.push_back(Vector3{-3 * scale, -2 * scale});
-    outline.push_back(Vector3{-2 * scale, -1 * scale});
-    outline.push_back(Vector3{2 * scale, -1 * scale});
-    outline.push_back(Vector3{3 * scale, -2 * scale});
-    outline.push_back(Vector3{4 * scale, -2 * scale});
-
-    return outline;
-}
-
-Mesh extrude(const std::vector<Vector3>& outline, const math::spline& s, double sampleRate) {
-    std::vector<double> splinePath{};
-    for(double i = 0; i <= s.getSegmentCount(); i += sampleRate) {
-        splinePath.push_back(i);
-    }
-
-    /*
-     *  +-----+-----+   Edgeloop 1, 3 vertices (+)
-     *  i     i     i   \
-     *  i     i     i    |
-     *  i     i     i     > Segment 1
-     *  i     i     i    |
-     *  i     i     i   /
-     *  +-----+-----+   Edgeloop 2
-     * 
-     * For each segment we have (vertices in outline/edgeloop -1) quads
-     * Each quads needs two vertices
-     */
-    int vertsInShape = outline.size();
-    int segments = splinePath.size() - 1;
-    int edgeLoops = segments + 1;
-    int triangles = (vertsInShape - 1) * segments * 2;
-
-    std::vector<Vector3> vertices{};
-    for(int i = 0; i < edgeLoops; i++) {
-        double uValue = splinePath.at(i);
-
-        oriented_point p{ s.getOrientedPoint(uValue) };
-        for(int vi = 0; vi < vertsInShape; vi++) {
-            Vector3 outlineinLocalCoordinates{ outline.at(vi) };
-            Vector3 outlineInWorldCoordinates{ p.localToWorld( math::vec::vec3d(outlineinLocalCoordinates.x, outlineinLocalCoordinates.y, outlineinLocalCoordinates.z) ).toVector3() };
-            vertices.push_back(outlineInWorldCoordinates);
-        }
-    }
-
-    //connect vertices with triangles
-    meshbuilder builder{ triangles };
-    for(int loop = 0; loop < edgeLoops - 1; loop++) {
-        int startIndexFirstLoop = vertsInShape * loop;
-        int startIndexSecondLoop = vertsInShape + startIndexFirstLoop;
-
-        for(int vi = 0; vi < vertsInShape - 1; vi++) {
-            Vector3 v1_loop1 = vertices.at(startIndexFirstLoop + vi);
-            Vector3 v2_loop1 = vertices.at(startIndexFirstLoop + vi + 1);
-            Vector3 v1_loop2 = vertices.at(startIndexSecondLoop + vi);
-            Vector3 v2_loop2 = vertices.at(startIndexSecondLoop + vi + 1);
-
-            builder.addTriangle(v1_loop1, v2_loop1, v1_loop2);
-            builder.addTriangle(v1_loop2, v2_loop1, v2_loop2);
-        }
-    }
-
-    return builder.build();
-}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+mapped_file::mapped_file(const std::string& path) {
+    HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(fileHandle == INVALID_HANDLE_VALUE) return;
+    file = fileHandle;
+
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) return;
+
+    mapping = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(!mapping) return;
+
+    view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if(view) length = (std::size_t) fileSize.QuadPart;
+}
+
+mapped_file::~mapped_file() {
+    if(view) UnmapViewOfFile(view);
+    if(mapping) CloseHandle(mapping);
+    if(file) CloseHandle(file);
+}
+
+#else
+
+mapped_file::mapped_file(const std::string& path) {
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if(descriptor < 0) return;
+
+    struct stat status;
+    if(fstat(descriptor, &status) == 0 && status.st_size > 0) {
+        void* address = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if(address != MAP_FAILED) {
+            view = address;
+            length = status.st_size;
+        }
+    }
+    close(descriptor);  //the mapping stays valid without the descriptor
+}
+
+mapped_file::~mapped_file() {
+    if(view) munmap(view, length);
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/*
+ * A whole file mapped read only into memory, unmapped again by the destructor.
+ * Lives in its own translation unit so windows.h never meets raylib.h (both declare CloseWindow, DrawText, ...).
+ */
+class mapped_file {
+public:
+    explicit mapped_file(const std::string& path);
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    bool isOpen() const {
+        return view != nullptr;
+    }
+
+    const unsigned char* data() const {
+        return (const unsigned char*) view;
+    }
+
+    std::size_t size() const {
+        return length;
+    }
+
+private:
+    void* view = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#endif
+};
+
+#endif
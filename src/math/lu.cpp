@@ -0,0 +1,134 @@
+#include "lu.h"
+
+namespace math {
+
+    //> Constructors
+
+    lu_decomposition::lu_decomposition(const matrix& m)
+    : size{ m.getAmountOfRows() }
+    {
+        if(m.getAmountOfRows() != m.getAmountOfColumns()) {
+            std::cerr << "Matrix is not square, cannot calculate lu decomposition";
+            size = 0;
+            singular = true;
+            return;
+        }
+
+        factors.resize(size * size);
+        for(int r = 0; r < size; r++) {
+            for(int c = 0; c < size; c++) factors[r * size + c] = m.get(r, c);
+        }
+
+        permutation.resize(size);
+        for(int i = 0; i < size; i++) permutation[i] = i;
+
+        for(int k = 0; k < size; k++) {
+            // pick the largest remaining value in column k as pivot
+            int pivotRow = k;
+            double pivotValue = std::abs(factors[k * size + k]);
+            for(int r = k + 1; r < size; r++) {
+                double value = std::abs(factors[r * size + k]);
+                if(value > pivotValue) {
+                    pivotValue = value;
+                    pivotRow = r;
+                }
+            }
+
+            if(pivotValue == 0) {
+                singular = true;
+                continue;
+            }
+
+            if(pivotRow != k) {
+                std::swap_ranges(factors.begin() + k * size, factors.begin() + (k + 1) * size, factors.begin() + pivotRow * size);
+                std::swap(permutation[k], permutation[pivotRow]);
+                permutationSign = -permutationSign;
+            }
+
+            double* pivotLine = &factors[k * size];
+            for(int r = k + 1; r < size; r++) {
+                double* line = &factors[r * size];
+                double factor = line[k] / pivotLine[k];
+                line[k] = factor;
+
+                for(int c = k + 1; c < size; c++) line[c] -= factor * pivotLine[c];
+            }
+        }
+    }
+
+    //> Properties
+
+    int lu_decomposition::getSize() const {
+        return size;
+    }
+
+    bool lu_decomposition::isSingular() const {
+        return singular;
+    }
+
+    //> Operations
+
+    double lu_decomposition::det() const {
+        if(singular) return 0;
+
+        double out = permutationSign;
+        for(int i = 0; i < size; i++) out *= factors[i * size + i];
+        return out;
+    }
+
+    // column holds P * b on entry and x on return
+    void lu_decomposition::solveInPlace(double* column) const {
+        for(int r = 0; r < size; r++) {
+            double value = column[r];
+            for(int c = 0; c < r; c++) value -= factors[r * size + c] * column[c];
+            column[r] = value;
+        }
+
+        for(int r = size - 1; r >= 0; r--) {
+            double value = column[r];
+            for(int c = r + 1; c < size; c++) value -= factors[r * size + c] * column[c];
+            column[r] = value / factors[r * size + r];
+        }
+    }
+
+    vec lu_decomposition::solve(const vec& b) const {
+        vec out{ size };
+        if(singular || b.getDimension() != size) {
+            std::cerr << "Matrix is singular or dimensions do not match, cannot solve";
+            return out;
+        }
+
+        std::vector<double> column(size);
+        for(int i = 0; i < size; i++) column[i] = b.get(permutation[i]);
+        solveInPlace(column.data());
+
+        out.set(column);
+        return out;
+    }
+
+    matrix lu_decomposition::solve(const matrix& b) const {
+        matrix out{ size, b.getAmountOfColumns() };
+        if(singular || b.getAmountOfRows() != size) {
+            std::cerr << "Matrix is singular or dimensions do not match, cannot solve";
+            return out;
+        }
+
+        std::vector<double> column(size);
+        for(int c = 0; c < b.getAmountOfColumns(); c++) {
+            for(int i = 0; i < size; i++) column[i] = b.get(permutation[i], c);
+            solveInPlace(column.data());
+            out.setColumn(c, column);
+        }
+
+        return out;
+    }
+
+    matrix lu_decomposition::inverse() const {
+        if(singular) {
+            std::cerr << "Det is equal to zero, cannot calculate inverse";
+            return matrix{ size, size };
+        }
+
+        return solve(matrix::identity(size));
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef LU_H
+#define LU_H
+
+#include <vector>
+
+#include "matrix.h"
+#include "vector.h"
+
+namespace math {
+
+    /*
+     * LU factorization with partial pivoting, P * A = L * U.
+     * 
+     * L (unit diagonal) and U are stored together in one n x n block. 
+     * Factorizing is O(n^3), after that det() is O(n) and every solve() is O(n^2), 
+     * so one factorization can be reused for many right hand sides.
+     */
+    class lu_decomposition {
+    public:
+
+    //> Constructors
+    lu_decomposition(const matrix& m);
+
+    //> Properties
+    int getSize() const;
+    bool isSingular() const;
+
+    //> Operations
+    double det() const;
+    vec solve(const vec& b) const;
+    matrix solve(const matrix& b) const;
+    matrix inverse() const;
+
+    private:
+        int size;
+        std::vector<double> factors{};   // row major, L below the diagonal, U on and above it
+        std::vector<int> permutation{};  // row i of P * A is row permutation[i] of A
+        int permutationSign = 1;
+        bool singular = false;
+
+        void solveInPlace(double* column) const;
+    };
+}
+
+#endif
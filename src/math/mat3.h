@@ -0,0 +1,258 @@
+#ifndef MAT3_H
+#define MAT3_H
+
+#include <iostream>
+#include <math.h>
+
+#include "matrix.h"
+#include "vec3.h"
+
+namespace math {
+
+    /*
+     * Dense 3x3 matrix, stored row major.
+     * Counterpart of vec3, the dynamic matrix stays around for arbitrary sizes.
+     */
+    template<typename T>
+    struct basic_mat3 {
+        using scalar = T;
+        using vector = basic_vec3<T>;
+
+        T m[3][3]{};
+
+    //> Constructors
+    constexpr basic_mat3() = default;
+
+    explicit basic_mat3(const matrix& other) {
+        for(int r = 0; r < 3; r++) {
+            for(int c = 0; c < 3; c++) m[r][c] = (T) other.get(r, c);
+        }
+    }
+
+    template<typename U>
+    explicit basic_mat3(const basic_mat3<U>& other) {
+        for(int r = 0; r < 3; r++) {
+            for(int c = 0; c < 3; c++) m[r][c] = (T) other.m[r][c];
+        }
+    }
+
+    static constexpr basic_mat3 identity() {
+        basic_mat3 out{};
+        out.m[0][0] = out.m[1][1] = out.m[2][2] = 1;
+        return out;
+    }
+
+    static basic_mat3 fromRows(const vector& r0, const vector& r1, const vector& r2) {
+        basic_mat3 out{};
+        out.setRow(0, r0).setRow(1, r1).setRow(2, r2);
+        return out;
+    }
+
+    static basic_mat3 fromColumns(const vector& c0, const vector& c1, const vector& c2) {
+        basic_mat3 out{};
+        out.setColumn(0, c0).setColumn(1, c1).setColumn(2, c2);
+        return out;
+    }
+
+    static basic_mat3 rot3d(T x, T y, T z);
+
+    //> Setter
+    basic_mat3& set(int rowIndex, int columnIndex, T value) {
+        m[rowIndex][columnIndex] = value;
+        return *this;
+    }
+
+    basic_mat3& setRow(int rowIndex, const vector& row) {
+        m[rowIndex][0] = row.x;
+        m[rowIndex][1] = row.y;
+        m[rowIndex][2] = row.z;
+        return *this;
+    }
+
+    basic_mat3& setColumn(int columnIndex, const vector& column) {
+        m[0][columnIndex] = column.x;
+        m[1][columnIndex] = column.y;
+        m[2][columnIndex] = column.z;
+        return *this;
+    }
+
+    //> Getter
+    T get(int rowIndex, int columnIndex) const {
+        return m[rowIndex][columnIndex];
+    }
+
+    T operator()(int rowIndex, int columnIndex) const {
+        return m[rowIndex][columnIndex];
+    }
+
+    vector getRow(int rowIndex) const {
+        return vector{ m[rowIndex][0], m[rowIndex][1], m[rowIndex][2] };
+    }
+
+    vector getColumn(int columnIndex) const {
+        return vector{ m[0][columnIndex], m[1][columnIndex], m[2][columnIndex] };
+    }
+
+    //> Operators
+    T det() const {
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+             - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+             + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    }
+
+    basic_mat3 transpose() const {
+        basic_mat3 out{};
+        for(int r = 0; r < 3; r++) {
+            for(int c = 0; c < 3; c++) out.m[c][r] = m[r][c];
+        }
+        return out;
+    }
+
+    // transpose() * v without building the transposed matrix
+    vector transposeMultiply(const vector& v) const {
+        return vector{
+            m[0][0] * v.x + m[1][0] * v.y + m[2][0] * v.z,
+            m[0][1] * v.x + m[1][1] * v.y + m[2][1] * v.z,
+            m[0][2] * v.x + m[1][2] * v.y + m[2][2] * v.z
+        };
+    }
+
+    basic_mat3 inverse() const {
+        T det = this->det();
+        if(det == 0) {
+            std::cerr << "Det is equal to zero, cannot calculate inverse";
+            return basic_mat3{};
+        }
+
+        // transposed cofactors divided by the determinant
+        basic_mat3 out{};
+        out.m[0][0] =  (m[1][1] * m[2][2] - m[1][2] * m[2][1]) / det;
+        out.m[0][1] = -(m[0][1] * m[2][2] - m[0][2] * m[2][1]) / det;
+        out.m[0][2] =  (m[0][1] * m[1][2] - m[0][2] * m[1][1]) / det;
+        out.m[1][0] = -(m[1][0] * m[2][2] - m[1][2] * m[2][0]) / det;
+        out.m[1][1] =  (m[0][0] * m[2][2] - m[0][2] * m[2][0]) / det;
+        out.m[1][2] = -(m[0][0] * m[1][2] - m[0][2] * m[1][0]) / det;
+        out.m[2][0] =  (m[1][0] * m[2][1] - m[1][1] * m[2][0]) / det;
+        out.m[2][1] = -(m[0][0] * m[2][1] - m[0][1] * m[2][0]) / det;
+        out.m[2][2] =  (m[0][0] * m[1][1] - m[0][1] * m[1][0]) / det;
+        return out;
+    }
+
+    basic_mat3& operator+=(const basic_mat3& other) {
+        for(int r = 0; r < 3; r++) {
+            for(int c = 0; c < 3; c++) m[r][c] += other.m[r][c];
+        }
+        return *this;
+    }
+
+    basic_mat3& operator-=(const basic_mat3& other) {
+        for(int r = 0; r < 3; r++) {
+            for(int c = 0; c < 3; c++) m[r][c] -= other.m[r][c];
+        }
+        return *this;
+    }
+
+    basic_mat3& operator*=(T value) {
+        for(int r = 0; r < 3; r++) {
+            for(int c = 0; c < 3; c++) m[r][c] *= value;
+        }
+        return *this;
+    }
+
+    basic_mat3& operator/=(T value) {
+        for(int r = 0; r < 3; r++) {
+            for(int c = 0; c < 3; c++) m[r][c] /= value;
+        }
+        return *this;
+    }
+
+    //> Export
+    matrix toMatrix() const {
+        matrix out{ 3, 3 };
+        for(int r = 0; r < 3; r++) {
+            for(int c = 0; c < 3; c++) out.set(r, c, m[r][c]);
+        }
+        return out;
+    }
+
+    //> More Operators
+    friend basic_mat3 operator*(const basic_mat3& m1, const basic_mat3& m2) {
+        basic_mat3 out{};
+        for(int r = 0; r < 3; r++) {
+            for(int c = 0; c < 3; c++) {
+                out.m[r][c] = m1.m[r][0] * m2.m[0][c] + m1.m[r][1] * m2.m[1][c] + m1.m[r][2] * m2.m[2][c];
+            }
+        }
+        return out;
+    }
+
+    friend vector operator*(const basic_mat3& m, const vector& v) {
+        return vector{
+            m.m[0][0] * v.x + m.m[0][1] * v.y + m.m[0][2] * v.z,
+            m.m[1][0] * v.x + m.m[1][1] * v.y + m.m[1][2] * v.z,
+            m.m[2][0] * v.x + m.m[2][1] * v.y + m.m[2][2] * v.z
+        };
+    }
+
+    friend basic_mat3 operator*(const basic_mat3& m, T val) {
+        basic_mat3 out{ m };
+        out *= val;
+        return out;
+    }
+
+    friend basic_mat3 operator*(T val, const basic_mat3& m) {
+        return m * val;
+    }
+
+    friend bool operator==(const basic_mat3& m1, const basic_mat3& m2) {
+        for(int r = 0; r < 3; r++) {
+            for(int c = 0; c < 3; c++) {
+                if(m1.m[r][c] != m2.m[r][c]) return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const basic_mat3& m1, const basic_mat3& m2) {
+        return !(m1 == m2);
+    }
+
+    friend std::ostream& operator<< (std::ostream& outPrint, const basic_mat3& m) {
+        outPrint << "[ 3x3" << std::endl;
+        for(int r = 0; r < 3; r++) {
+            for(int c = 0; c < 3; c++) {
+                outPrint << "\t" << m.m[r][c];
+                if(c < 2) outPrint << "\t";
+            }
+            outPrint << std::endl;
+        }
+        outPrint << "]";
+
+        return outPrint;
+    }
+    };
+
+    using mat3 = basic_mat3<double>;
+    using mat3f = basic_mat3<float>;
+
+    template<typename T>
+    basic_mat3<T> basic_mat3<T>::rot3d(T x, T y, T z) {
+        basic_mat3 rotX = fromRows({ 1, 0, 0 }, { 0, cos(x), -sin(x) }, { 0, sin(x), cos(x) });
+        basic_mat3 rotY = fromRows({ cos(y), 0, sin(y) }, { 0, 1, 0 }, { -sin(y), 0, cos(y) });
+        basic_mat3 rotZ = fromRows({ cos(z), -sin(z), 0 }, { sin(z), cos(z), 0 }, { 0, 0, 1 });
+
+        return rotX * rotY * rotZ;
+    }
+
+    // local to world rotation of a frame looking along forward, its columns are the local x, y and z axes
+    template<typename T>
+    basic_mat3<T> lookRotation(const basic_vec3<T>& inForward, const basic_vec3<T>& up) {
+        basic_vec3<T> forward = inForward.normalize();
+        basic_vec3<T> binormal = up.cross(forward).normalize();
+        basic_vec3<T> normal = forward.cross(binormal).normalize();
+
+        return basic_mat3<T>::fromColumns(binormal, normal, forward);
+    }
+}
+
+#endif
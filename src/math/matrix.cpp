@@ -1,5 +1,6 @@
 #include "matrix.h"
 #include "vector.h"
+#include "lu.h"
 
 namespace math {
    
@@ -46,7 +47,7 @@ namespace math {
             return *this;
         }
 
-        matrixRepresentation[{rowIndex, columnIndex}] = value;
+        matrixRepresentation[rowIndex * amountOfColumns + columnIndex] = value;
 
         return *this;
     }
@@ -80,12 +81,7 @@ namespace math {
             return 0;
         }
 
-        std::pair<int, int> index{ rowIndex, columnIndex };
-        if(matrixRepresentation.find(index) != matrixRepresentation.end()) {
-            return matrixRepresentation.at(index);
-        }
-
-        return 0;
+        return matrixRepresentation[rowIndex * amountOfColumns + columnIndex];
     }
 
     vec matrix::getColumn(int columnIndex) {
@@ -131,21 +127,15 @@ namespace math {
 
     //> Operations
 
-    double matrix::det() {
+    double matrix::det() const {
         if(getAmountOfColumns() != getAmountOfRows()) {
             return 0;
         }
 
-        double out = 0;
-        for(int currentColumn = 0; currentColumn < getAmountOfColumns(); currentColumn++) {
-            out += get(0, currentColumn) * get(1, (currentColumn + 1                       ) % getAmountOfColumns()) * get(1, (currentColumn + 2                       ) % getAmountOfColumns());
-            out -= get(0, currentColumn) * get(1, (currentColumn - 1 + getAmountOfColumns()) % getAmountOfColumns()) * get(1, (currentColumn - 2 + getAmountOfColumns()) % getAmountOfColumns());
-        }
-
-        return out;
+        return lu().det();
     }
 
-    matrix matrix::transpose() {
+    matrix matrix::transpose() const {
         matrix out{ getAmountOfColumns(), getAmountOfRows() };
 
         for(int r = 0; r < getAmountOfRows(); r++) {
@@ -157,7 +147,7 @@ namespace math {
         return out;
     }
 
-    matrix matrix::submatrix(const std::vector<int>& deletedRows, const std::vector<int>& deleteColumns) {
+    matrix matrix::submatrix(const std::vector<int>& deletedRows, const std::vector<int>& deleteColumns) const {
         matrix out{ getAmountOfRows() - (int) deletedRows.size(), getAmountOfColumns() - (int) deleteColumns.size() };
 
         int rowOffset = 0;
@@ -181,7 +171,8 @@ namespace math {
         return out;
     }
 
-    matrix matrix::adjoint() {
+    // classical adjoint, the transposed cofactor matrix. O(n^5), use lu() for anything but tiny matrices
+    matrix matrix::adjoint() const {
         if(getAmountOfColumns() != getAmountOfRows()) {
             std::cerr << "Matrix is not square, cannot calculate adjoint";
             int min  = std::min(getAmountOfColumns(), getAmountOfRows());
@@ -194,87 +185,125 @@ namespace math {
                 matrix minor{ submatrix({ rowIndex }, { columnIndex }) };
 
                 double sign = (rowIndex + columnIndex) % 2 == 0? 1: -1;
-                out.set(rowIndex, columnIndex, sign * minor.det());
+                out.set(columnIndex, rowIndex, sign * minor.det());
             }
         }
 
         return out;
     }
 
-    matrix matrix::inverse() {
-        double det = this->det();
-        if(det == 0) {
-            std::cerr << "Det is equal to zero, cannot calculate inverse";
+    matrix matrix::inverse() const {
+        if(getAmountOfColumns() != getAmountOfRows()) {
+            std::cerr << "Matrix is not square, cannot calculate inverse";
             return matrix{ amountOfColumns, amountOfColumns };
         }
-        
-        return det * adjoint();
+
+        return lu().inverse();
+    }
+
+    lu_decomposition matrix::lu() const {
+        return lu_decomposition{ *this };
+    }
+
+    // for several right hand sides factorize once with lu() and reuse it
+    vec matrix::solve(const vec& b) const {
+        return lu().solve(b);
     }
 
     //more operations
 
+    bool matrix::dimensionsMismatch(const matrix& otherMatrix) const {
+        if(sameDimensions(otherMatrix)) return false;
+
+        std::cout << "ERROR: Matrix ranks do not match" << std::endl; 
+        return true;
+    }
+
     matrix& matrix::operator+=(const matrix& otherMatrix) {
-        if(!sameDimensions(otherMatrix)) {
-            std::cout << "ERROR: Matrix ranks do not match" << std::endl; 
-        }
+        if(dimensionsMismatch(otherMatrix)) return *this;
 
-        for(int r = 0; r < amountOfRows; r++) {
-            for(int c = 0; c < amountOfColumns; c++) {
-                set(r, c, get(r, c) + otherMatrix.get(r, c));
-            }
+        for(int i = 0; i < (int) matrixRepresentation.size(); i++) {
+            matrixRepresentation[i] += otherMatrix.matrixRepresentation[i];
         }
 
         return *this;
     }
 
     matrix& matrix::operator-=(const matrix& otherMatrix) {
-        if(!sameDimensions(otherMatrix)) {
-            std::cout << "ERROR: Matrix ranks do not match" << std::endl; 
-        }
+        if(dimensionsMismatch(otherMatrix)) return *this;
 
-        for(int r = 0; r < amountOfRows; r++) {
-            for(int c = 0; c < amountOfColumns; c++) {
-                set(r, c, get(r, c) - otherMatrix.get(r, c));
-            }
+        for(int i = 0; i < (int) matrixRepresentation.size(); i++) {
+            matrixRepresentation[i] -= otherMatrix.matrixRepresentation[i];
         }
 
         return *this;
     }
 
     matrix& matrix::operator*=(double value) {
-        for(int r = 0; r < amountOfRows; r++) {
-            for(int c = 0; c < amountOfColumns; c++) {
-                set(r, c, get(r, c) * value);
-            }
+        for(double& element: matrixRepresentation) element *= value;
+        return *this;
+    }
+
+    matrix& matrix::operator/=(double value) {
+        for(double& element: matrixRepresentation) element /= value;
+        return *this;
+    }
+
+    // this += factor * otherMatrix in a single pass, without a temporary for the scaled matrix
+    matrix& matrix::addScaled(const matrix& otherMatrix, double factor) {
+        if(dimensionsMismatch(otherMatrix)) return *this;
+
+        for(int i = 0; i < (int) matrixRepresentation.size(); i++) {
+            matrixRepresentation[i] += factor * otherMatrix.matrixRepresentation[i];
         }
 
         return *this;
     }
 
-    matrix& matrix::operator/=(double value) {
-        for(int r = 0; r < amountOfRows; r++) {
-            for(int c = 0; c < amountOfColumns; c++) {
-                set(r, c, get(r, c) / value);
-            }
+    // this = weights[0] * matrices[0] + weights[1] * matrices[1] + ..., one pass over the elements
+    matrix& matrix::setLinearCombination(std::initializer_list<double> weights, std::initializer_list<const matrix*> matrices) {
+        if(weights.size() != matrices.size()) {
+            std::cout << "ERROR: Linear combination needs one weight per matrix" << std::endl;
+            return *this;
+        }
+        for(const matrix* m: matrices) {
+            if(dimensionsMismatch(*m)) return *this;
+        }
+
+        for(int i = 0; i < (int) matrixRepresentation.size(); i++) {
+            double sum = 0;
+            const double* weight = weights.begin();
+            for(const matrix* m: matrices) sum += *weight++ * m->matrixRepresentation[i];
+            matrixRepresentation[i] = sum;
         }
 
         return *this;
     }
 
+    // The rvalue overloads reuse the storage of the temporary, so chained expressions
+    // like a + 4 * b + c only allocate once.
     matrix operator+(const matrix& v1, const matrix& v2) {
-        matrix out{ v1.getAmountOfRows(), v1.getAmountOfColumns() };
-        out += v1;
+        matrix out{ v1 };
         out += v2;
         return out;
     }
 
+    matrix operator+(matrix&& v1, const matrix& v2) {
+        v1 += v2;
+        return std::move(v1);
+    }
+
     matrix operator-(const matrix& v1, const matrix& v2) {
-        matrix out{ v1.getAmountOfRows(), v1.getAmountOfColumns() };
-        out += v1;
+        matrix out{ v1 };
         out -= v2;
         return out;
     }
 
+    matrix operator-(matrix&& v1, const matrix& v2) {
+        v1 -= v2;
+        return std::move(v1);
+    }
+
     matrix operator*(const matrix& v1, const matrix& v2) {
         matrix out{ v1.getAmountOfRows(), v2.getAmountOfColumns() };
         if(v1.getAmountOfColumns() != v2.getAmountOfRows()) {
@@ -296,27 +325,53 @@ namespace math {
     }
 
     vec operator*(const matrix& v1, const vec& v2) {
-        return (v1 * (matrix) v2).getColumn(0);
+        vec out{ v1.getAmountOfRows() };
+        if(v1.getAmountOfColumns() != v2.getDimension()) {
+            std::cout << "ERROR: column rank does not match row rank";
+            return out;
+        }
+
+        for(int r = 0; r < v1.getAmountOfRows(); r++) {
+            double value = 0;
+            for(int k = 0; k < v1.getAmountOfColumns(); k++) {
+                value += v1.get(r, k) * v2.get(k);
+            }
+            out.set(r, value);
+        }
+
+        return out;
     }
 
     matrix operator*(const matrix& v1, float val) {
-        matrix out{ v1.getAmountOfRows(), v1.getAmountOfColumns() };
-        out += v1;
+        matrix out{ v1 };
         out *= val;
         return out;
     }
 
+    matrix operator*(matrix&& v1, float val) {
+        v1 *= val;
+        return std::move(v1);
+    }
+
     matrix operator*(float val, const matrix& v) {
         return v * val;
     }
 
+    matrix operator*(float val, matrix&& v) {
+        return std::move(v) * val;
+    }
+
     matrix operator/(const matrix& v1, float val) {
-        matrix out{ v1.getAmountOfRows(), v1.getAmountOfColumns() };
-        out += v1;
+        matrix out{ v1 };
         out /= val;
         return out;
     }
 
+    matrix operator/(matrix&& v1, float val) {
+        v1 /= val;
+        return std::move(v1);
+    }
+
     matrix operator/(float val, const matrix& v) {
         return v * val;
     }
@@ -341,6 +396,11 @@ namespace math {
         return out;
     }
 
+    matrix operator-(matrix&& v1) {
+        v1 *= -1;
+        return std::move(v1);
+    }
+
     bool operator== (const matrix& v1, const matrix& v2) {
         if(!v1.sameDimensions(v2)) return false;
 
@@ -2,14 +2,15 @@
 #define MATRIX_H
 
 #include <iostream>
-#include <map>
 #include <math.h>
 #include <vector>
 #include <algorithm>
+#include <initializer_list>
 
 namespace math {
     class vec;
     class matrix;
+    class lu_decomposition;
     matrix operator*(const matrix& v1, const matrix& v2);
     
     class matrix {
@@ -17,12 +18,28 @@ namespace math {
     
     //> Constructors
     matrix(int rows, int columns) 
-    :amountOfRows{ rows }, amountOfColumns{ columns }
+    :amountOfRows{ rows }, amountOfColumns{ columns }, matrixRepresentation(std::max(rows * columns, 0), 0.0)
     { }
 
-    matrix(const matrix& m) 
-    : amountOfRows{ m.amountOfRows }, amountOfColumns{ m.amountOfColumns }, matrixRepresentation{ m.matrixRepresentation }
-    { }
+    matrix(const matrix& m) = default;
+
+    matrix(matrix&& m) noexcept
+    : amountOfRows{ m.amountOfRows }, amountOfColumns{ m.amountOfColumns }, matrixRepresentation{ std::move(m.matrixRepresentation) }
+    { 
+        m.amountOfRows = 0;
+        m.amountOfColumns = 0;
+    }
+
+    matrix& operator=(const matrix& m) = default;
+
+    matrix& operator=(matrix&& m) noexcept {
+        amountOfRows = m.amountOfRows;
+        amountOfColumns = m.amountOfColumns;
+        matrixRepresentation = std::move(m.matrixRepresentation);
+        m.amountOfRows = 0;
+        m.amountOfColumns = 0;
+        return *this;
+    }
 
     static matrix identity(int rank) {
         matrix out{rank, rank};
@@ -76,42 +93,54 @@ namespace math {
     bool sameDimensions(const matrix& otherMatrix) const;
 
     //> Operators
-    double det();
-    matrix transpose();
-    matrix submatrix(const std::vector<int>& deletedRows, const std::vector<int>& deleteColumns);
-    matrix adjoint();
-    matrix inverse();
+    double det() const;
+    matrix transpose() const;
+    matrix submatrix(const std::vector<int>& deletedRows, const std::vector<int>& deleteColumns) const;
+    matrix adjoint() const;
+    matrix inverse() const;
+
+    lu_decomposition lu() const;
+    vec solve(const vec& b) const;
 
     matrix& operator+=(const matrix& otherMatrix);
     matrix& operator-=(const matrix& otherMatrix);
     matrix& operator*=(double value);
     matrix& operator/=(double value);
+    matrix& addScaled(const matrix& otherMatrix, double factor);
+    matrix& setLinearCombination(std::initializer_list<double> weights, std::initializer_list<const matrix*> matrices);
 
     //> Export
 
     private:
         int amountOfRows;
         int amountOfColumns;
-        std::map<std::pair<int, int>, double> matrixRepresentation{};
+        std::vector<double> matrixRepresentation; // row major, amountOfRows * amountOfColumns values
 
         bool positionOutOfBounds(int rowIndex, int columnIndex) const;
+        bool dimensionsMismatch(const matrix& otherMatrix) const;
     };
 
     //> More Operators
     matrix operator+(const matrix& v1, const matrix& v2);
+    matrix operator+(matrix&& v1, const matrix& v2);
     matrix operator-(const matrix& v1, const matrix& v2);
+    matrix operator-(matrix&& v1, const matrix& v2);
 
     matrix operator*(const matrix& v1, const matrix& v2);
     vec operator*(const matrix& v1, const vec& v2);
 
     matrix operator*(const matrix& v, float val);
+    matrix operator*(matrix&& v, float val);
     matrix operator*(float val, const matrix& v);
+    matrix operator*(float val, matrix&& v);
 
     matrix operator/(const matrix& v, float val);
+    matrix operator/(matrix&& v, float val);
     matrix operator/(float val, const matrix& v);
     std::ostream& operator<< (std::ostream& out, const matrix& m);
 
     matrix operator-(const matrix& v1);
+    matrix operator-(matrix&& v1);
     bool operator== (const matrix& v1, const matrix& v2);
     bool operator!= (const matrix& v1, const matrix& v2);
 
@@ -0,0 +1,196 @@
+#ifndef QUAT_H
+#define QUAT_H
+
+#include <iostream>
+#include <math.h>
+
+#include "vec3.h"
+#include "mat3.h"
+
+namespace math {
+
+    /*
+     * Unit quaternion w + xi + yj + zk describing a rotation.
+     * Compact alternative to a mat3 for storing and blending frames,
+     * rotate(v) gives the same result as toMatrix() * v.
+     */
+    template<typename T>
+    struct basic_quat {
+        using scalar = T;
+        using vector = basic_vec3<T>;
+        using matrix = basic_mat3<T>;
+
+        T w{ 1 };
+        T x{};
+        T y{};
+        T z{};
+
+    //> Constructors
+    constexpr basic_quat() = default;
+
+    constexpr basic_quat(T inW, T inX, T inY, T inZ)
+    : w{ inW }, x{ inX }, y{ inY }, z{ inZ }
+    { }
+
+    static constexpr basic_quat identity() {
+        return basic_quat{ 1, 0, 0, 0 };
+    }
+
+    static basic_quat fromAxisAngle(const vector& axis, T angleInRadians) {
+        vector normalizedAxis{ axis.normalize() };
+        T s = sin(angleInRadians / 2);
+        return basic_quat{ cos(angleInRadians / 2), normalizedAxis.x * s, normalizedAxis.y * s, normalizedAxis.z * s };
+    }
+
+    // expects an orthonormal matrix with determinant 1
+    static basic_quat fromMatrix(const matrix& r) {
+        const auto& m = r.m;
+        T trace = m[0][0] + m[1][1] + m[2][2];
+
+        basic_quat out{};
+        if(trace > 0) {
+            T s = (T) 0.5 / std::sqrt(trace + 1);
+            out = basic_quat{ (T) 0.25 / s, (m[2][1] - m[1][2]) * s, (m[0][2] - m[2][0]) * s, (m[1][0] - m[0][1]) * s };
+        } else if(m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+            T s = 2 * std::sqrt(1 + m[0][0] - m[1][1] - m[2][2]);
+            out = basic_quat{ (m[2][1] - m[1][2]) / s, (T) 0.25 * s, (m[0][1] + m[1][0]) / s, (m[0][2] + m[2][0]) / s };
+        } else if(m[1][1] > m[2][2]) {
+            T s = 2 * std::sqrt(1 + m[1][1] - m[0][0] - m[2][2]);
+            out = basic_quat{ (m[0][2] - m[2][0]) / s, (m[0][1] + m[1][0]) / s, (T) 0.25 * s, (m[1][2] + m[2][1]) / s };
+        } else {
+            T s = 2 * std::sqrt(1 + m[2][2] - m[0][0] - m[1][1]);
+            out = basic_quat{ (m[1][0] - m[0][1]) / s, (m[0][2] + m[2][0]) / s, (m[1][2] + m[2][1]) / s, (T) 0.25 * s };
+        }
+
+        return out.normalize();
+    }
+
+    // same orientation as math::lookRotation(forward, up)
+    static basic_quat fromLookRotation(const vector& forward, const vector& up) {
+        return fromMatrix(lookRotation(forward, up));
+    }
+
+    //> Properties
+    T length() const {
+        return std::sqrt(w * w + x * x + y * y + z * z);
+    }
+
+    constexpr T dot(const basic_quat& q2) const {
+        return w * q2.w + x * q2.x + y * q2.y + z * q2.z;
+    }
+
+    //> Operations
+    basic_quat& normalize() {
+        T length = (*this).length();
+        if(length == 0) {
+            *this = identity();
+            return *this;
+        }
+
+        w /= length; x /= length; y /= length; z /= length;
+        return *this;
+    }
+
+    basic_quat normalize() const {
+        basic_quat out{ *this };
+        out.normalize();
+        return out;
+    }
+
+    constexpr basic_quat conjugate() const {
+        return basic_quat{ w, -x, -y, -z };
+    }
+
+    // rotates v without building a matrix, v' = v + 2w(q x v) + 2q x (q x v)
+    constexpr vector rotate(const vector& v) const {
+        vector axis{ x, y, z };
+        vector t{ axis.cross(v) * 2 };
+        return v + t * w + axis.cross(t);
+    }
+
+    constexpr vector inverseRotate(const vector& v) const {
+        return conjugate().rotate(v);
+    }
+
+    matrix toMatrix() const {
+        matrix out{};
+        out.m[0][0] = 1 - 2 * (y * y + z * z);
+        out.m[0][1] = 2 * (x * y - w * z);
+        out.m[0][2] = 2 * (x * z + w * y);
+        out.m[1][0] = 2 * (x * y + w * z);
+        out.m[1][1] = 1 - 2 * (x * x + z * z);
+        out.m[1][2] = 2 * (y * z - w * x);
+        out.m[2][0] = 2 * (x * z - w * y);
+        out.m[2][1] = 2 * (y * z + w * x);
+        out.m[2][2] = 1 - 2 * (x * x + y * y);
+        return out;
+    }
+
+    //> More Operators
+    friend constexpr basic_quat operator*(const basic_quat& q1, const basic_quat& q2) {
+        return basic_quat{
+            q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z,
+            q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y,
+            q1.w * q2.y - q1.x * q2.z + q1.y * q2.w + q1.z * q2.x,
+            q1.w * q2.z + q1.x * q2.y - q1.y * q2.x + q1.z * q2.w
+        };
+    }
+
+    friend constexpr bool operator==(const basic_quat& q1, const basic_quat& q2) {
+        return q1.w == q2.w && q1.x == q2.x && q1.y == q2.y && q1.z == q2.z;
+    }
+
+    friend constexpr bool operator!=(const basic_quat& q1, const basic_quat& q2) {
+        return !(q1 == q2);
+    }
+
+    friend std::ostream& operator<< (std::ostream& out, const basic_quat& q) {
+        out << "( " << q.w << " | " << q.x << " | " << q.y << " | " << q.z << " )";
+        return out;
+    }
+    };
+
+    using quat = basic_quat<double>;
+    using quatf = basic_quat<float>;
+
+    //> Interpolation, both take the shorter way around
+
+    // normalized linear interpolation, cheap and good enough for nearby frames
+    template<typename T>
+    basic_quat<T> nlerp(const basic_quat<T>& start, typename basic_quat<T>::scalar t, const basic_quat<T>& end) {
+        T sign = start.dot(end) < 0? -1: 1;
+        return basic_quat<T>{
+            start.w + (sign * end.w - start.w) * t,
+            start.x + (sign * end.x - start.x) * t,
+            start.y + (sign * end.y - start.y) * t,
+            start.z + (sign * end.z - start.z) * t
+        }.normalize();
+    }
+
+    // spherical linear interpolation, constant angular velocity
+    template<typename T>
+    basic_quat<T> slerp(const basic_quat<T>& start, typename basic_quat<T>::scalar t, const basic_quat<T>& end) {
+        T cosAngle = start.dot(end);
+        T sign = 1;
+        if(cosAngle < 0) {
+            cosAngle = -cosAngle;
+            sign = -1;
+        }
+
+        if(cosAngle > (T) 0.9995) return nlerp(start, t, end);
+
+        T angle = std::acos(cosAngle);
+        T sinAngle = std::sin(angle);
+        T startFactor = std::sin((1 - t) * angle) / sinAngle;
+        T endFactor = sign * std::sin(t * angle) / sinAngle;
+
+        return basic_quat<T>{
+            start.w * startFactor + end.w * endFactor,
+            start.x * startFactor + end.x * endFactor,
+            start.y * startFactor + end.y * endFactor,
+            start.z * startFactor + end.z * endFactor
+        };
+    }
+}
+
+#endif
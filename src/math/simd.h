@@ -0,0 +1,119 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <algorithm>
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace math {
+namespace simd {
+
+    /*
+     * Minimal wrappers around a SIMD register holding `width` values of T, only what the batched
+     * spline evaluation needs. pack<T> is the widest one the compiler targets:
+     * AVX (256 bit, with -mavx or -march=native), SSE2 (128 bit, every x86-64 build) and
+     * scalar_pack everywhere else (e.g. the emscripten build).
+     * scalar_pack is also used for the samples left over at the end of a batch.
+     */
+    template<typename T>
+    struct scalar_pack {
+        static constexpr int width = 1;
+        T value;
+
+        static scalar_pack load(const T* in) { return scalar_pack{ *in }; }
+        static scalar_pack broadcast(T in) { return scalar_pack{ in }; }
+        void store(T* out) const { *out = value; }
+
+        friend scalar_pack operator+(scalar_pack a, scalar_pack b) { return scalar_pack{ a.value + b.value }; }
+        friend scalar_pack operator*(scalar_pack a, scalar_pack b) { return scalar_pack{ a.value * b.value }; }
+        friend scalar_pack operator/(scalar_pack a, scalar_pack b) { return scalar_pack{ a.value / b.value }; }
+        friend scalar_pack sqrt(scalar_pack a) { return scalar_pack{ std::sqrt(a.value) }; }
+        friend scalar_pack max(scalar_pack a, scalar_pack b) { return scalar_pack{ std::max(a.value, b.value) }; }
+    };
+
+    template<typename T>
+    struct native_pack {
+        using type = scalar_pack<T>;
+    };
+
+#if defined(__AVX__)
+
+    struct pack_m256d {
+        static constexpr int width = 4;
+        __m256d value;
+
+        static pack_m256d load(const double* in) { return pack_m256d{ _mm256_loadu_pd(in) }; }
+        static pack_m256d broadcast(double in) { return pack_m256d{ _mm256_set1_pd(in) }; }
+        void store(double* out) const { _mm256_storeu_pd(out, value); }
+
+        friend pack_m256d operator+(pack_m256d a, pack_m256d b) { return pack_m256d{ _mm256_add_pd(a.value, b.value) }; }
+        friend pack_m256d operator*(pack_m256d a, pack_m256d b) { return pack_m256d{ _mm256_mul_pd(a.value, b.value) }; }
+        friend pack_m256d operator/(pack_m256d a, pack_m256d b) { return pack_m256d{ _mm256_div_pd(a.value, b.value) }; }
+        friend pack_m256d sqrt(pack_m256d a) { return pack_m256d{ _mm256_sqrt_pd(a.value) }; }
+        friend pack_m256d max(pack_m256d a, pack_m256d b) { return pack_m256d{ _mm256_max_pd(a.value, b.value) }; }
+    };
+
+    struct pack_m256 {
+        static constexpr int width = 8;
+        __m256 value;
+
+        static pack_m256 load(const float* in) { return pack_m256{ _mm256_loadu_ps(in) }; }
+        static pack_m256 broadcast(float in) { return pack_m256{ _mm256_set1_ps(in) }; }
+        void store(float* out) const { _mm256_storeu_ps(out, value); }
+
+        friend pack_m256 operator+(pack_m256 a, pack_m256 b) { return pack_m256{ _mm256_add_ps(a.value, b.value) }; }
+        friend pack_m256 operator*(pack_m256 a, pack_m256 b) { return pack_m256{ _mm256_mul_ps(a.value, b.value) }; }
+        friend pack_m256 operator/(pack_m256 a, pack_m256 b) { return pack_m256{ _mm256_div_ps(a.value, b.value) }; }
+        friend pack_m256 sqrt(pack_m256 a) { return pack_m256{ _mm256_sqrt_ps(a.value) }; }
+        friend pack_m256 max(pack_m256 a, pack_m256 b) { return pack_m256{ _mm256_max_ps(a.value, b.value) }; }
+    };
+
+    template<> struct native_pack<double> { using type = pack_m256d; };
+    template<> struct native_pack<float> { using type = pack_m256; };
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+    struct pack_m128d {
+        static constexpr int width = 2;
+        __m128d value;
+
+        static pack_m128d load(const double* in) { return pack_m128d{ _mm_loadu_pd(in) }; }
+        static pack_m128d broadcast(double in) { return pack_m128d{ _mm_set1_pd(in) }; }
+        void store(double* out) const { _mm_storeu_pd(out, value); }
+
+        friend pack_m128d operator+(pack_m128d a, pack_m128d b) { return pack_m128d{ _mm_add_pd(a.value, b.value) }; }
+        friend pack_m128d operator*(pack_m128d a, pack_m128d b) { return pack_m128d{ _mm_mul_pd(a.value, b.value) }; }
+        friend pack_m128d operator/(pack_m128d a, pack_m128d b) { return pack_m128d{ _mm_div_pd(a.value, b.value) }; }
+        friend pack_m128d sqrt(pack_m128d a) { return pack_m128d{ _mm_sqrt_pd(a.value) }; }
+        friend pack_m128d max(pack_m128d a, pack_m128d b) { return pack_m128d{ _mm_max_pd(a.value, b.value) }; }
+    };
+
+    struct pack_m128 {
+        static constexpr int width = 4;
+        __m128 value;
+
+        static pack_m128 load(const float* in) { return pack_m128{ _mm_loadu_ps(in) }; }
+        static pack_m128 broadcast(float in) { return pack_m128{ _mm_set1_ps(in) }; }
+        void store(float* out) const { _mm_storeu_ps(out, value); }
+
+        friend pack_m128 operator+(pack_m128 a, pack_m128 b) { return pack_m128{ _mm_add_ps(a.value, b.value) }; }
+        friend pack_m128 operator*(pack_m128 a, pack_m128 b) { return pack_m128{ _mm_mul_ps(a.value, b.value) }; }
+        friend pack_m128 operator/(pack_m128 a, pack_m128 b) { return pack_m128{ _mm_div_ps(a.value, b.value) }; }
+        friend pack_m128 sqrt(pack_m128 a) { return pack_m128{ _mm_sqrt_ps(a.value) }; }
+        friend pack_m128 max(pack_m128 a, pack_m128 b) { return pack_m128{ _mm_max_ps(a.value, b.value) }; }
+    };
+
+    template<> struct native_pack<double> { using type = pack_m128d; };
+    template<> struct native_pack<float> { using type = pack_m128; };
+
+#endif
+
+    template<typename T>
+    using pack = typename native_pack<T>::type;
+}
+}
+
+#endif
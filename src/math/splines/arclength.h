@@ -0,0 +1,126 @@
+#ifndef ARCLENGTH_H
+#define ARCLENGTH_H
+
+#include <vector>
+#include <algorithm>
+
+#include "./spline.h"
+
+namespace math {
+
+    /*
+     * Maps u to the distance travelled along a spline and back.
+     *
+     * Every segment is split into samplesPerSegment pieces. The length of each piece is
+     * integrated with 5 point Gauss-Legendre quadrature (exact up to degree 9, a cubic piece is
+     * within ~1e-10 of the true length), the table stores u, the distance from u = 0 and the
+     * speed |dp/du| at every piece boundary.
+     * Between two entries distanceAtU and uAtDistance use the cubic Hermite interpolant through
+     * the stored distances and speeds, so a query is a binary search plus a handful of multiplies,
+     * no root-find.
+     *
+     *  arclength_table table{ s };
+     *  distance += speed;                      //constant speed along the track
+     *  double u = table.uAtDistance(distance);
+     */
+    template<typename T>
+    class basic_arclength_table {
+    public:
+        basic_arclength_table(const basic_spline<T>& spline, int samplesPerSegment = 16) {
+            int segmentCount = spline.getSegmentCount();
+            samplesPerSegment = std::max(1, samplesPerSegment);
+
+            us.reserve(segmentCount * samplesPerSegment + 1);
+            distances.reserve(segmentCount * samplesPerSegment + 1);
+            speeds.reserve(segmentCount * samplesPerSegment + 1);
+
+            us.push_back(0);
+            distances.push_back(0);
+            speeds.push_back(segmentCount > 0? speedAt(spline, 0, 0): 0);
+
+            for(int segment = 0; segment < segmentCount; segment++) {
+                for(int i = 0; i < samplesPerSegment; i++) {
+                    double start = (double) i / samplesPerSegment;
+                    double end = (double) (i + 1) / samplesPerSegment;
+
+                    us.push_back(segment + end);
+                    distances.push_back(distances.back() + integrate(spline, segment, start, end));
+                    speeds.push_back(speedAt(spline, segment, end));
+                }
+            }
+        }
+
+        double getLength() const {
+            return distances.back();
+        }
+
+        // distance along the spline from u = 0, u is clamped to [0, getSegmentCount()]
+        double distanceAtU(double u) const {
+            if(!(u > us.front())) return 0;
+            if(u >= us.back()) return distances.back();
+
+            int i = (int) (std::upper_bound(us.begin(), us.end(), u) - us.begin()) - 1;
+            double h = us[i + 1] - us[i];
+            return hermite(distances[i], distances[i + 1], speeds[i] * h, speeds[i + 1] * h, (u - us[i]) / h);
+        }
+
+        // the u at which the spline has covered distance, distance is clamped to [0, getLength()]
+        double uAtDistance(double distance) const {
+            if(!(distance > 0)) return 0;
+            if(distance >= distances.back()) return us.back();
+
+            int i = (int) (std::upper_bound(distances.begin(), distances.end(), distance) - distances.begin()) - 1;
+            double h = distances[i + 1] - distances[i];
+            double t = (distance - distances[i]) / h;
+
+            // du/ds = 1 / speed, fall back to linear where the spline stops (e.g. double control points)
+            double du = us[i + 1] - us[i];
+            if(!(speeds[i] > minimumSpeed && speeds[i + 1] > minimumSpeed)) return us[i] + du * t;
+
+            double u = hermite(us[i], us[i + 1], h / speeds[i], h / speeds[i + 1], t);
+            return std::max(us[i], std::min(u, us[i + 1]));
+        }
+
+    private:
+        static constexpr double minimumSpeed = 1e-9;
+
+        std::vector<double> us{};
+        std::vector<double> distances{};
+        std::vector<double> speeds{};
+
+        static double hermite(double start, double end, double startTangent, double endTangent, double t) {
+            double t2 = t * t;
+            double t3 = t2 * t;
+            return (2 * t3 - 3 * t2 + 1) * start + (t3 - 2 * t2 + t) * startTangent +
+                   (-2 * t3 + 3 * t2) * end + (t3 - t2) * endTangent;
+        }
+
+        // |dp/du| at progress t on segment, the cubic splines use their polynomial, everything else a central difference
+        static double speedAt(const basic_spline<T>& spline, int segment, double t) {
+            cubic_polynomial<T> polynomial{};
+            if(spline.getSegmentPolynomial(segment, polynomial)) return vec3{ polynomial.getVelocity((T) t) }.length();
+
+            const double h = 1e-5;
+            double start = segment + std::max(0.0, t - h);
+            double end = segment + std::min(1.0, t + h);
+            return vec3{ spline.get(end) - spline.get(start) }.length() / (end - start);
+        }
+
+        static double integrate(const basic_spline<T>& spline, int segment, double start, double end) {
+            static constexpr double nodes[5] = { 0, -0.5384693101056831, 0.5384693101056831, -0.9061798459386640, 0.9061798459386640 };
+            static constexpr double weights[5] = { 0.5688888888888889, 0.4786286704993665, 0.4786286704993665, 0.2369268850561891, 0.2369268850561891 };
+
+            double halfWidth = (end - start) / 2;
+            double center = (end + start) / 2;
+
+            double length = 0;
+            for(int i = 0; i < 5; i++) length += weights[i] * speedAt(spline, segment, center + halfWidth * nodes[i]);
+            return length * halfWidth;
+        }
+    };
+
+    using arclength_table = basic_arclength_table<double>;
+    using arclength_tablef = basic_arclength_table<float>;
+}
+
+#endif
@@ -1,68 +1,194 @@
 #ifndef BEZIER_H
 #define BEZIER_H
 
+#include <utility>
+
 #include "./spline.h"
+#include "./bezierspline.h"
 
 namespace math {
 
-    class bezier : public spline {
+    /*
+     * A single bezier curve of any degree, the control points 0 and n lie on the curve.
+     *
+     * get and getDerivate do not allocate. They run Horner's scheme on the Bernstein form with the
+     * binomial coefficients and the derivative control points (hodograph) precomputed at construction,
+     * that is O(n) per evaluation instead of the O(n^2) of de Casteljau.
+     * For long curves toBezierSpline converts the curve into piecewise cubics.
+     */
+    template<typename T>
+    class basic_bezier : public basic_spline<T> {
     public:
+        using vector = basic_vec3<T>;
+
+        basic_bezier(std::vector<vector> inControlPoints)
+        : basic_spline<T>{ std::move(inControlPoints) }
+        {
+            const std::vector<vector>& c{ this->controlPoints };
+            int degree = getDegree();
+
+            binomials = binomialsOf(degree);
+            derivativeBinomials = binomialsOf(std::max(0, degree - 1));
+
+            for(int i = 0; i + 1 < (int) c.size(); i++) hodograph.push_back((c.at(i + 1) - c.at(i)) * (T) degree);
+        }
+
+        // every point has global support, the whole curve changes
+        std::vector<segment_range> setControlPoint(int index, const vector& point) {
+            std::vector<vector>& c{ this->controlPoints };
+            c.at(index) = point;
+
+            T degree = (T) getDegree();
+            if(index > 0) hodograph.at(index - 1) = (c.at(index) - c.at(index - 1)) * degree;
+            if(index < (int) hodograph.size()) hodograph.at(index) = (c.at(index + 1) - c.at(index)) * degree;
+
+            return { segment_range{ 0, this->getSegmentCount() } };
+        }
+
+        int getDegree() const {
+            return (int) this->controlPoints.size() - 1;
+        }
 
-        bezier(std::vector<vec> inControlPoints)
-        : spline{ inControlPoints}
-        { }
+        vector getPositionByPercentage(double t) const {
+            return get(t * this->getSegmentCount());
+        }
 
-        vec getPositionByPercentage(double t) {
-            return get(t * getSegmentCount());
+        vector get(double u) const {
+            if(this->controlPoints.empty()) return vector{};
+            return evaluate(this->controlPoints, binomials, toT(u));
         }
 
-        vec get(double u) const { 
-            if(u < 0) return get(0);
-            if(u > getSegmentCount()) return get(getSegmentCount());
+        vector getDerivate(double u) const {
+            if(hodograph.empty()) return vector{};
+            return evaluate(hodograph, derivativeBinomials, toT(u)).normalize();
+        }
 
-            double t = u / getSegmentCount();
-            std::vector<vec> casteljauInput{ controlPoints };
+        // dp/dt at t in [0, 1], not normalized
+        vector getVelocityByPercentage(double t) const {
+            if(hodograph.empty()) return vector{};
+            return evaluate(hodograph, derivativeBinomials, std::max(0.0, std::min(t, 1.0)));
+        }
 
-            while(casteljauInput.size() > 1) {
-                std::vector<vec> casteljauOutput{};
+        // splits the curve at t in [0, 1] into two curves of the same degree (de Casteljau)
+        std::pair<basic_bezier, basic_bezier> subdivide(double t) const {
+            std::vector<vector> points{ this->controlPoints };
+            std::vector<vector> left{};
+            std::vector<vector> right(points.size());
 
-                for(int i = 0; i < casteljauInput.size() - 1; i++) {
-                    casteljauOutput.push_back(lerp(casteljauInput.at(i), t, casteljauInput.at(i + 1)));
-                }
+            int n = (int) points.size();
+            for(int level = 0; level < n; level++) {
+                left.push_back(points.at(0));
+                right.at(n - 1 - level) = points.at(n - 1 - level);
 
-                casteljauInput = casteljauOutput;
+                for(int i = 0; i < n - 1 - level; i++) points.at(i) = math::lerp(points.at(i), (T) t, points.at(i + 1));
             }
 
-            return casteljauInput.at(0);
+            return { basic_bezier{ std::move(left) }, basic_bezier{ std::move(right) } };
         }
 
-        vec getDerivate(double u) const { 
-            if(u < 0) return get(0);
-            if(u > getSegmentCount()) return get(getSegmentCount());
+        // the same curve with one more control point
+        basic_bezier elevate() const {
+            const std::vector<vector>& c{ this->controlPoints };
+            int n = getDegree() + 1;
 
-            double t = u / getSegmentCount();
-            std::vector<vec> casteljauInput{ controlPoints };
+            std::vector<vector> out{ c.front() };
+            for(int i = 1; i < n; i++) {
+                T a = (T) i / n;
+                out.push_back(c.at(i - 1) * a + c.at(i) * (1 - a));
+            }
+            out.push_back(c.back());
 
-            while(casteljauInput.size() > 2) {
-                std::vector<vec> casteljauOutput{};
+            return basic_bezier{ std::move(out) };
+        }
 
-                for(int i = 0; i < casteljauInput.size() - 1; i++) {
-                    casteljauOutput.push_back(lerp(casteljauInput.at(i), t, casteljauInput.at(i + 1)));
-                }
+        /*
+         * A curve with one control point less. Exact if this curve was elevated before,
+         * otherwise an approximation that keeps both end points: the first half of the points
+         * comes from inverting elevate() from the start, the second half from the end.
+         */
+        basic_bezier reduce() const {
+            const std::vector<vector>& c{ this->controlPoints };
+            int n = getDegree();
+            if(n < 2) return *this;
+
+            std::vector<vector> fromStart(n);
+            fromStart.at(0) = c.front();
+            for(int i = 1; i < n; i++) fromStart.at(i) = (c.at(i) * (T) n - fromStart.at(i - 1) * (T) i) / (T) (n - i);
+
+            std::vector<vector> fromEnd(n);
+            fromEnd.at(n - 1) = c.back();
+            for(int i = n - 1; i > 0; i--) fromEnd.at(i - 1) = (c.at(i) * (T) n - fromEnd.at(i) * (T) (n - i)) / (T) i;
+
+            std::vector<vector> out{};
+            for(int i = 0; i < n; i++) out.push_back(2 * i < n? fromStart.at(i): fromEnd.at(i));
+            return basic_bezier{ std::move(out) };
+        }
 
-                casteljauInput = casteljauOutput;
+        /*
+         * Approximates the curve with pieces cubic segments of equal t length. Each cubic matches the
+         * position and velocity at both of its ends, so the result is C1 and the error falls with pieces^4.
+         */
+        basic_bezier_spline<T> toBezierSpline(int pieces) const {
+            pieces = std::max(1, pieces);
+
+            std::vector<vector> points{ getPositionByPercentage(0) };
+            for(int i = 0; i < pieces; i++) {
+                double start = (double) i / pieces;
+                double end = (double) (i + 1) / pieces;
+                T third = (T) ((end - start) / 3);
+
+                vector endPoint{ getPositionByPercentage(end) };
+                points.push_back(points.back() + getVelocityByPercentage(start) * third);
+                points.push_back(endPoint - getVelocityByPercentage(end) * third);
+                points.push_back(endPoint);
             }
 
-            return casteljauInput.at(1) - casteljauInput.at(2);
+            return basic_bezier_spline<T>{ std::move(points) };
         }
 
     private:
+        std::vector<double> binomials{};
+        std::vector<double> derivativeBinomials{};
+        std::vector<vector> hodograph{};
+
+        double toT(double u) const {
+            int segmentCount = this->getSegmentCount();
+            if(segmentCount <= 0) return 0;
+            return std::max(0.0, std::min(u / segmentCount, 1.0));
+        }
 
-        vec lerp(vec start, double t, vec end) const {
-            return vec{ start} * (1 - t) + vec{ end } * t;
+        static std::vector<double> binomialsOf(int n) {
+            std::vector<double> out{ 1 };
+            for(int i = 1; i <= n; i++) out.push_back(out.back() * (n - i + 1) / i);
+            return out;
+        }
+
+        /*
+         * Horner's scheme on the Bernstein form: sum C(n, i) t^i (1 - t)^(n - i) b_i.
+         * Powers of the smaller of t and 1 - t are accumulated, so nothing over- or underflows for t near 1.
+         */
+        static vector evaluate(const std::vector<vector>& points, const std::vector<double>& binomials, double t) {
+            int n = (int) points.size() - 1;
+            if(n == 0) return points.front();
+
+            bool reversed = t > 0.5;
+            double s = reversed? t: 1 - t;
+            double r = reversed? 1 - t: t;
+            auto point = [&](int i) -> const vector& { return points[reversed? n - i: i]; };
+
+            // the weights are computed in double, the points stay in T
+            vector out{ point(0) };
+            double power = 1;
+            for(int i = 1; i <= n; i++) {
+                power *= r;
+                out = out * (T) s + point(i) * (T) (binomials[i] * power);
+            }
+            return out;
         }
-        
     };
+
+    using bezier = basic_bezier<double>;
+    using bezierf = basic_bezier<float>;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,57 +1,41 @@
 #ifndef BEZIERSPLINE_H
 #define BEZIERSPLINE_H
 
-#include "./spline.h"
-#include "./cubicbezier.h"
+#include "./cubicspline.h"
 
 namespace math {
 
-    class bezier_spline : public spline {
+    template<typename T>
+    class basic_bezier_spline : public basic_cubic_spline<T> {
     public:
+        using vector = basic_vec3<T>;
 
-        bezier_spline(std::vector<vec> controlPoints)
-        : spline{controlPoints}
-        { }
-
-        vec get(double u) const { 
-            if(u < 0) return get(0);
-            if(u > getSegmentCount()) return get(getSegmentCount());
-            if(u == getSegmentCount()) return controlPoints.at(controlPoints.size() - 1);
-
-            int startIndex = std::floor(u) * 3; // 4 points form a cubic bezier curve
-
-            double t = u;
-            while(t > 1) t -= 1; 
-            
-            return cubic_bezier{ controlPoints.at(startIndex), controlPoints.at(startIndex + 1), controlPoints.at(startIndex + 2), controlPoints.at(startIndex + 3) }
-                    .get(t);
-        }
-
-        vec getDerivate(double u) const {
-            if(u < 0) return getDerivate(0);
-            if(u > getSegmentCount()) return getDerivate(getSegmentCount());
-            if(u == getSegmentCount()) return getDerivate(getSegmentCount() - 0.000001);
-
+        basic_bezier_spline(std::vector<vector> controlPoints)
+        : basic_cubic_spline<T>{controlPoints}
+        { 
             // 4 points form a cubic bezier curve
             // 0 - 1 - 2 - 3 - 4 - 5 - 6
             // ^           ^           ^
-            // so multiplying by 3 gets the control points that lay on the curve
-            int startIndex = std::floor(u) * 3;
-            
-            double t = u;
-            while(t > 1) t -= 1; 
-            
-            return cubic_bezier{ controlPoints.at(startIndex), controlPoints.at(startIndex + 1), controlPoints.at(startIndex + 2), controlPoints.at(startIndex + 3) }
-                    .getDerivate(t);
+            // so every third control point lays on the curve
+            this->rebuildSegments(((int) this->controlPoints.size() - 1) / 3);
         }
 
-        int getSegmentCount() const {
-            return std::floor(spline::getSegmentCount() / 3);
+        // the points on the curve are shared by two segments, the others belong to one
+        std::vector<segment_range> setControlPoint(int index, const vector& point) {
+            this->controlPoints.at(index) = point;
+            return { this->updateSegments(index % 3 == 0? index / 3 - 1: index / 3, index / 3 + 1) };
         }
 
-    private:
-        
+    protected:
+        cubic_polynomial<T> buildSegment(int segment) const {
+            const std::vector<vector>& c{ this->controlPoints };
+            int startIndex = segment * 3;
+            return bezier_segment<T>{ c.at(startIndex), c.at(startIndex + 1), c.at(startIndex + 2), c.at(startIndex + 3) }.toPolynomial();
+        }
     };
+
+    using bezier_spline = basic_bezier_spline<double>;
+    using bezier_splinef = basic_bezier_spline<float>;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,62 +1,37 @@
 #ifndef BSPLINE_H
 #define BSPLINE_H
 
-#include "./spline.h"
+#include "./cubicspline.h"
 
 namespace math {
 
-    class b_spline : public spline {
+    template<typename T>
+    class basic_b_spline : public basic_cubic_spline<T> {
     public:
+        using vector = basic_vec3<T>;
 
-        b_spline(std::vector<vec> inControlPoints)
-        : spline{inControlPoints}
-        { }
-
-        vec get(double u) const { 
-            if(u < 0) return get(0);
-            if(u > getSegmentCount()) return get(getSegmentCount());
-
-            int startIndex = (int) std::floor(u) + 1;
-            
-            vec p1 = controlPoints.at(startIndex - 1);
-            vec p2 = controlPoints.at(startIndex + 0);
-            vec p3 = controlPoints.at(startIndex + 1);
-            vec p4 = controlPoints.at(startIndex + 2);
-
-            double t = u;
-            while(t > 1) t -= 1; 
-
-            return (1  * (p1 + 4 * p2 + p3)/6.0 + 
-                    t   * (-3 * p1 + 3 * p3)/6.0 +
-                    t*t  * (3 * p1 - 6 * p2 + 3 * p3)/6.0 + 
-                    t*t*t * (-p1 + 3 * p2 - 3 * p3 + p4)/6.0);
-
+        basic_b_spline(std::vector<vector> inControlPoints)
+        : basic_cubic_spline<T>{inControlPoints}
+        { 
+            // every 4 consecutive points form one segment
+            this->rebuildSegments((int) this->controlPoints.size() - 3);
         }
 
-        vec getDerivate(double u) const {
-            if(u < 0) return getDerivate(0);
-            if(u > getSegmentCount()) return getDerivate(getSegmentCount());
-
-            int startIndex = (int) std::floor(u) + 1;
-            
-            vec p1 = controlPoints.at(startIndex - 1);
-            vec p2 = controlPoints.at(startIndex + 0);
-            vec p3 = controlPoints.at(startIndex + 1);
-            vec p4 = controlPoints.at(startIndex + 2);
-
-            double t = u;
-            while(t > 1) t -= 1; 
-
-            return (1   * (-3 * p1 + 3 * p3)/6.0 +
-                    2*t  * (3 * p1 - 6 * p2 + 3 * p3)/6.0 + 
-                    3*t*t * (-p1 + 3 * p2 - 3 * p3 + p4)/6.0).normalize();
-            
+        // point i is part of the segments i - 3 to i
+        std::vector<segment_range> setControlPoint(int index, const vector& point) {
+            this->controlPoints.at(index) = point;
+            return { this->updateSegments(index - 3, index + 1) };
         }
 
-         int getSegmentCount() const {
-            return spline::getSegmentCount() - 2;
+    protected:
+        cubic_polynomial<T> buildSegment(int segment) const {
+            const std::vector<vector>& c{ this->controlPoints };
+            return bspline_segment<T>{ c.at(segment), c.at(segment + 1), c.at(segment + 2), c.at(segment + 3) }.toPolynomial();
         }
     };
+
+    using b_spline = basic_b_spline<double>;
+    using b_splinef = basic_b_spline<float>;
 };
 
-#endif
\ No newline at end of file
+#endif
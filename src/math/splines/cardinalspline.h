@@ -6,28 +6,62 @@
 
 namespace math {
 
-    class cardinal_spline : public hermit_spline {
+    template<typename T>
+    class basic_cardinal_spline : public basic_hermit_spline<T> {
     public:
+        using vector = basic_vec3<T>;
 
-        cardinal_spline(std::vector<vec> inControlPoints, double scale = 1, bool loop = false)
-        : hermit_spline{inControlPoints, {} }
+        basic_cardinal_spline(std::vector<vector> inControlPoints, double scale = 1, bool inLoop = false)
+        : basic_hermit_spline<T>{inControlPoints, {} }, loop{ inLoop }, lastIndex{ (int) inControlPoints.size() - 1 }
         { 
-            std::vector<vec> velocities{};
-            int lastIndex = controlPoints.size() - 1;
+            std::vector<vector>& controlPoints{ this->controlPoints };
+            std::vector<vector> velocities{};
 
-            velocities.push_back((controlPoints.at(1) - controlPoints.at(0)) * 2);
-            for(int i = 1; i < lastIndex; i++) velocities.push_back(controlPoints.at(i + 1) - controlPoints.at(i - 1));
-            velocities.push_back((controlPoints.at(lastIndex) - controlPoints.at(lastIndex - 1)) * 2);
+            for(int i = 0; i <= lastIndex; i++) velocities.push_back(velocityAt(i));
             
             if(!loop) {
                 velocities.push_back(velocities.at(0));
                 controlPoints.push_back(controlPoints.at(0));
             }
 
-            setVelocities(velocities);
+            this->setVelocities(velocities);
+        }
+
+        /*
+         * The velocities of the point and its two neighbours change, so up to 4 segments are rebuilt.
+         * Without loop the first point is repeated at the end, moving it also changes the last segment.
+         */
+        std::vector<segment_range> setControlPoint(int index, const vector& point) {
+            std::vector<vector>& controlPoints{ this->controlPoints };
+            std::vector<vector>& velocities{ this->velocities };
+
+            controlPoints.at(index) = point;
+            for(int i = std::max(0, index - 1); i <= std::min(index + 1, lastIndex); i++) velocities.at(i) = velocityAt(i);
+
+            std::vector<segment_range> out{ this->updateSegments(index - 2, index + 2) };
+            if(!loop && index <= 1) {
+                controlPoints.back() = controlPoints.at(0);
+                velocities.back() = velocities.at(0);
+                out.push_back(this->updateSegments(lastIndex, lastIndex + 1));
+            }
+            return out;
+        }
+
+    private:
+        bool loop;
+        int lastIndex;
+
+        vector velocityAt(int i) const {
+            const std::vector<vector>& controlPoints{ this->controlPoints };
+
+            if(i == 0) return (controlPoints.at(1) - controlPoints.at(0)) * 2;
+            if(i == lastIndex) return (controlPoints.at(lastIndex) - controlPoints.at(lastIndex - 1)) * 2;
+            return controlPoints.at(i + 1) - controlPoints.at(i - 1);
         }
-    
     };
+
+    using cardinal_spline = basic_cardinal_spline<double>;
+    using cardinal_splinef = basic_cardinal_spline<float>;
 };
 
-#endif
\ No newline at end of file
+#endif
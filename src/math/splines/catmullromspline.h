@@ -6,14 +6,18 @@
 
 namespace math {
 
-    class catmullrom_spline : public cardinal_spline {
+    template<typename T>
+    class basic_catmullrom_spline : public basic_cardinal_spline<T> {
     public:
 
-        catmullrom_spline(std::vector<vec> inControlPoints)
-        : cardinal_spline{inControlPoints, 0.5 }
+        basic_catmullrom_spline(std::vector<basic_vec3<T>> inControlPoints)
+        : basic_cardinal_spline<T>{inControlPoints, 0.5 }
         { }
     
     };
+
+    using catmullrom_spline = basic_catmullrom_spline<double>;
+    using catmullrom_splinef = basic_catmullrom_spline<float>;
 };
 
-#endif
\ No newline at end of file
+#endif
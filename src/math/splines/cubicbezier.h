@@ -1,54 +1,36 @@
 #ifndef CUBICBEZIER_H
 #define CUBICBEZIER_H
 
-#include "./spline.h"
+#include "./cubicspline.h"
 
 namespace math {
 
-    class cubic_bezier : public spline {
+    // a single segment, t means values in [0, 1]
+    template<typename T>
+    class basic_cubic_bezier : public basic_cubic_spline<T> {
     public:
+        using vector = basic_vec3<T>;
 
-        cubic_bezier(vec c1, vec c2, vec c3, vec c4)
-        : spline{{ c1, c2, c3, c4 }}
-        { }
-
-        //t means values in [0, 1]
-        vec get(double t) const { 
-            if(t < 0) return get(0);
-            if(t > getSegmentCount()) return get(getSegmentCount());
-
-            const vec& c1{ controlPoints.at(0) };
-            const vec& c2{ controlPoints.at(1) };
-            const vec& c3{ controlPoints.at(2) };
-            const vec& c4{ controlPoints.at(3) };
-
-            return (c1 + 
-                    t  * (-3 * c1 + 3 * c2) +
-                    t*t * (3 * c1 - 6 * c2 + 3 * c3) + 
-                    t*t*t * ( -c1 + 3 * c2 - 3 * c3 + c4));
+        basic_cubic_bezier(vector c1, vector c2, vector c3, vector c4)
+        : basic_cubic_spline<T>{{ c1, c2, c3, c4 }}
+        { 
+            this->rebuildSegments(1);
         }
 
-        vec getDerivate(double t) const { 
-            if(t < 0) return getDerivate(0);
-            if(t > getSegmentCount()) return getDerivate(getSegmentCount());
-
-            const vec& c1{ controlPoints.at(0) };
-            const vec& c2{ controlPoints.at(1) };
-            const vec& c3{ controlPoints.at(2) };
-            const vec& c4{ controlPoints.at(3) };
-
-            return (1  * (-3 * c1 + 3 * c2) +
-                    2*t * (3 * c1 - 6 * c2 + 3 * c3) + 
-                    3*t*t * ( -c1 + 3 * c2 - 3 * c3 + c4)).normalize();
+        std::vector<segment_range> setControlPoint(int index, const vector& point) {
+            this->controlPoints.at(index) = point;
+            return { this->updateSegments(0, 1) };
         }
 
-        int getSegmentCount() const {
-            return 1;
+    protected:
+        cubic_polynomial<T> buildSegment(int segment) const {
+            const std::vector<vector>& c{ this->controlPoints };
+            return bezier_segment<T>{ c.at(0), c.at(1), c.at(2), c.at(3) }.toPolynomial();
         }
-
-    private:
-        
     };
+
+    using cubic_bezier = basic_cubic_bezier<double>;
+    using cubic_bezierf = basic_cubic_bezier<float>;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,117 @@
+#ifndef CUBICSEGMENT_H
+#define CUBICSEGMENT_H
+
+#include "../vec3.h"
+
+namespace math {
+
+    /*
+     * Characteristic matrices of the cubic splines.
+     *
+     * A segment is given by 4 geometry vectors g0..g3 (what they mean depends on the basis),
+     * the polynomial coefficients are c_j = sum_i matrix[j][i] * g_i and
+     *
+     *  p(t) = c0 + c1 * t + c2 * t^2 + c3 * t^3,    t in [0, 1]
+     */
+
+    // g = start position, start velocity, end position, end velocity
+    struct hermite_basis {
+        static constexpr double matrix[4][4] = {
+            {  1,  0,  0,  0 },
+            {  0,  1,  0,  0 },
+            { -3, -2,  3, -1 },
+            {  2,  1, -2,  1 }
+        };
+    };
+
+    // g = p(i-1), p(i), p(i+1), p(i+2), the curve runs from p(i) to p(i+1)
+    struct catmullrom_basis {
+        static constexpr double matrix[4][4] = {
+            {  0,    1,    0,    0   },
+            { -0.5,  0,    0.5,  0   },
+            {  1,   -2.5,  2,   -0.5 },
+            { -0.5,  1.5, -1.5,  0.5 }
+        };
+    };
+
+    // g = p(i-1), p(i), p(i+1), p(i+2), uniform cubic b-spline, does not run through the points
+    struct bspline_basis {
+        static constexpr double matrix[4][4] = {
+            {  1.0 / 6,  4.0 / 6,  1.0 / 6,  0       },
+            { -3.0 / 6,  0,        3.0 / 6,  0       },
+            {  3.0 / 6, -6.0 / 6,  3.0 / 6,  0       },
+            { -1.0 / 6,  3.0 / 6, -3.0 / 6,  1.0 / 6 }
+        };
+    };
+
+    // g = the 4 control points of a cubic bezier curve
+    struct bezier_basis {
+        static constexpr double matrix[4][4] = {
+            {  1,  0,  0,  0 },
+            { -3,  3,  0,  0 },
+            {  3, -6,  3,  0 },
+            { -1,  3, -3,  1 }
+        };
+    };
+
+    /*
+     * A cubic in power basis, p(t) = c0 + c1 * t + c2 * t^2 + c3 * t^3.
+     * This is what the cubic splines cache per segment, evaluating it is 3 multiply-adds per axis.
+     */
+    template<typename T>
+    struct cubic_polynomial {
+        using vector = basic_vec3<T>;
+
+        vector coefficients[4];
+
+    constexpr vector get(T t) const {
+        return ((coefficients[3] * t + coefficients[2]) * t + coefficients[1]) * t + coefficients[0];
+    }
+
+    // dp/dt, not normalized
+    constexpr vector getVelocity(T t) const {
+        return (coefficients[3] * (3 * t) + coefficients[2] * 2) * t + coefficients[1];
+    }
+    };
+
+    /*
+     * One cubic segment, evaluated without virtual calls or allocations.
+     * The basis is known at compile time, so the loops below get fully unrolled.
+     */
+    template<typename Basis, typename T>
+    struct cubic_segment {
+        using vector = basic_vec3<T>;
+
+        vector geometry[4];
+
+    constexpr cubic_segment(const vector& g0, const vector& g1, const vector& g2, const vector& g3)
+    : geometry{ g0, g1, g2, g3 }
+    { }
+
+    constexpr vector coefficient(int power) const {
+        vector out{};
+        for(int i = 0; i < 4; i++) out += geometry[i] * (T) Basis::matrix[power][i];
+        return out;
+    }
+
+    constexpr vector get(T t) const {
+        return ((coefficient(3) * t + coefficient(2)) * t + coefficient(1)) * t + coefficient(0);
+    }
+
+    // dp/dt, not normalized (unlike spline::getDerivate)
+    constexpr vector getVelocity(T t) const {
+        return (coefficient(3) * (3 * t) + coefficient(2) * 2) * t + coefficient(1);
+    }
+
+    constexpr cubic_polynomial<T> toPolynomial() const {
+        return cubic_polynomial<T>{{ coefficient(0), coefficient(1), coefficient(2), coefficient(3) }};
+    }
+    };
+
+    template<typename T> using hermite_segment = cubic_segment<hermite_basis, T>;
+    template<typename T> using catmullrom_segment = cubic_segment<catmullrom_basis, T>;
+    template<typename T> using bspline_segment = cubic_segment<bspline_basis, T>;
+    template<typename T> using bezier_segment = cubic_segment<bezier_basis, T>;
+}
+
+#endif
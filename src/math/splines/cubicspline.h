@@ -0,0 +1,170 @@
+#ifndef CUBICSPLINE_H
+#define CUBICSPLINE_H
+
+#include <limits>
+
+#include "./spline.h"
+#include "./cubicsegment.h"
+#include "../simd.h"
+
+namespace math {
+
+    /*
+     * Base for the piecewise cubic splines (hermit, cardinal, catmull-rom, b-spline, bezier).
+     *
+     * The subclasses turn their control points into one cubic_polynomial per segment (buildSegment)
+     * when they are constructed, so get and getDerivate only have to find the segment and run Horner's scheme.
+     * When a control point moves only the segments in its support are rebuilt, see updateSegments.
+     */
+    template<typename T>
+    class basic_cubic_spline : public basic_spline<T> {
+    public:
+        using vector = basic_vec3<T>;
+
+        basic_cubic_spline(std::vector<vector> inControlPoints)
+        : basic_spline<T>{ std::move(inControlPoints) }
+        { }
+
+        vector get(double u) const {
+            if(polynomials.empty()) return vector{};
+
+            double t;
+            int segment = locateSegment(u, t);
+            return polynomials[segment].get((T) t);
+        }
+
+        vector getDerivate(double u) const {
+            if(polynomials.empty()) return vector{};
+
+            double t;
+            int segment = locateSegment(u, t);
+            return polynomials[segment].getVelocity((T) t).normalize();
+        }
+
+        int getSegmentCount() const {
+            return polynomials.size();
+        }
+
+        bool getSegmentPolynomial(int segment, cubic_polynomial<T>& out) const {
+            if(segment < 0 || segment >= (int) polynomials.size()) return false;
+
+            out = polynomials[segment];
+            return true;
+        }
+
+        const cubic_polynomial<T>& getPolynomial(int segment) const {
+            return polynomials.at(segment);
+        }
+
+        // index of the segment u lies in and the progress t on it, u is clamped to [0, getSegmentCount()]
+        int locateSegment(double u, double& t) const {
+            int lastSegment = (int) polynomials.size() - 1;
+
+            if(!(u > 0)) {
+                t = 0;
+                return 0;
+            }
+
+            if(u >= lastSegment + 1) {
+                t = 1;
+                return lastSegment;
+            }
+
+            int segment = (int) u;
+            t = u - segment;
+            return segment;
+        }
+
+    protected:
+        std::vector<cubic_polynomial<T>> polynomials{};
+
+        // the power basis form of one segment, computed from the current control points
+        virtual cubic_polynomial<T> buildSegment(int segment) const = 0;
+
+        void rebuildSegments(int segmentCount) {
+            polynomials.clear();
+            polynomials.reserve(std::max(0, segmentCount));
+            for(int i = 0; i < segmentCount; i++) polynomials.push_back(buildSegment(i));
+        }
+
+        // rebuilds the segments first to last - 1 (clamped to the existing ones) and returns that range
+        segment_range updateSegments(int first, int last) {
+            segment_range range{ std::max(0, first), std::min(last, (int) polynomials.size()) };
+            for(int i = range.first; i < range.last; i++) polynomials[i] = buildSegment(i);
+            return range;
+        }
+
+        /*
+         * Splits the samples into runs that lie on the same segment (the whole batch is usually
+         * sorted, so runs are long) and evaluates each run a SIMD register at a time.
+         * The t values are parked in tangents.x until the kernel overwrites them, so no scratch memory is needed.
+         */
+        void evaluateSamples(const double* us, int count, basic_vec3_array<T>& positions, basic_vec3_array<T>& tangents) const {
+            if(polynomials.empty()) {
+                for(int i = 0; i < count; i++) {
+                    positions.set(i, vector{});
+                    tangents.set(i, vector{});
+                }
+                return;
+            }
+
+            int runStart = 0;
+            while(runStart < count) {
+                double t;
+                int segment = locateSegment(us[runStart], t);
+                tangents.x[runStart] = (T) t;
+
+                int runEnd = runStart + 1;
+                for(; runEnd < count; runEnd++) {
+                    if(locateSegment(us[runEnd], t) != segment) break;
+                    tangents.x[runEnd] = (T) t;
+                }
+
+                using pack = simd::pack<T>;
+                const cubic_polynomial<T>& polynomial{ polynomials[segment] };
+
+                int i = runStart;
+                for(; i + pack::width <= runEnd; i += pack::width) evaluateLanes<pack>(polynomial, i, positions, tangents);
+                for(; i < runEnd; i++) evaluateLanes<simd::scalar_pack<T>>(polynomial, i, positions, tangents);
+
+                runStart = runEnd;
+            }
+        }
+
+    private:
+        // same operations in the same order as cubic_polynomial::get / getVelocity and vec3::normalize,
+        // so every lane matches the scalar get and getDerivate
+        template<typename Pack>
+        static void evaluateLanes(const cubic_polynomial<T>& polynomial, int i, basic_vec3_array<T>& positions, basic_vec3_array<T>& tangents) {
+            const vector* c = polynomial.coefficients;
+
+            Pack t{ Pack::load(&tangents.x[i]) };
+            Pack threeT{ Pack::broadcast(3) * t };
+            Pack two{ Pack::broadcast(2) };
+
+            Pack px{ ((Pack::broadcast(c[3].x) * t + Pack::broadcast(c[2].x)) * t + Pack::broadcast(c[1].x)) * t + Pack::broadcast(c[0].x) };
+            Pack py{ ((Pack::broadcast(c[3].y) * t + Pack::broadcast(c[2].y)) * t + Pack::broadcast(c[1].y)) * t + Pack::broadcast(c[0].y) };
+            Pack pz{ ((Pack::broadcast(c[3].z) * t + Pack::broadcast(c[2].z)) * t + Pack::broadcast(c[1].z)) * t + Pack::broadcast(c[0].z) };
+
+            Pack vx{ (Pack::broadcast(c[3].x) * threeT + Pack::broadcast(c[2].x) * two) * t + Pack::broadcast(c[1].x) };
+            Pack vy{ (Pack::broadcast(c[3].y) * threeT + Pack::broadcast(c[2].y) * two) * t + Pack::broadcast(c[1].y) };
+            Pack vz{ (Pack::broadcast(c[3].z) * threeT + Pack::broadcast(c[2].z) * two) * t + Pack::broadcast(c[1].z) };
+
+            // a zero velocity stays zero instead of dividing by 0
+            Pack length{ sqrt(vx * vx + vy * vy + vz * vz) };
+            Pack factor{ Pack::broadcast(1) / max(length, Pack::broadcast(std::numeric_limits<T>::min())) };
+
+            px.store(&positions.x[i]);
+            py.store(&positions.y[i]);
+            pz.store(&positions.z[i]);
+            (vx * factor).store(&tangents.x[i]);
+            (vy * factor).store(&tangents.y[i]);
+            (vz * factor).store(&tangents.z[i]);
+        }
+    };
+
+    using cubic_spline = basic_cubic_spline<double>;
+    using cubic_splinef = basic_cubic_spline<float>;
+};
+
+#endif
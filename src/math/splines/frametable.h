@@ -0,0 +1,204 @@
+#ifndef FRAMETABLE_H
+#define FRAMETABLE_H
+
+#include <vector>
+#include <algorithm>
+
+#include "./spline.h"
+#include "../quat.h"
+
+namespace math {
+
+    /*
+     * Rotation minimizing frames of a spline, built once and looked up afterwards.
+     *
+     * spline::getOrientedPoint builds every frame from the world up axis, which twists the track
+     * when it turns and breaks down where the tangent is vertical. This table starts with that
+     * frame at u = 0 and carries it along the spline with the double reflection method
+     * (Wang et al., "Computation of Rotation Minimizing Frames", 2008): at every sample the frame
+     * is mirrored onto the next position and then onto the next tangent, so it never rolls
+     * around the tangent on its own.
+     *
+     * Optionally a roll (banking) angle in radians can be given for every integer u,
+     * 0 to getSegmentCount(), it is interpolated linearly in between and applied around the tangent.
+     *
+     * After an edit of the spline update() rebuilds the affected samples only.
+     *
+     * The samples lie at u = i / samplesPerSegment. getOrientedPoint(u) evaluates the position on
+     * the spline and nlerps the rotation between the two neighbouring samples, the spline has to
+     * outlive the table.
+     */
+    template<typename T>
+    class basic_frame_table {
+    public:
+        using vector = basic_vec3<T>;
+
+        basic_frame_table(const basic_spline<T>& inSpline, int inSamplesPerSegment = 32, std::vector<double> inRoll = {})
+        : spline{ &inSpline }, samplesPerSegment{ std::max(1, inSamplesPerSegment) }, roll{ std::move(inRoll) }
+        {
+            int sampleCount = inSpline.getSegmentCount() * samplesPerSegment + 1;
+            poses.resize(sampleCount);
+            references.resize(sampleCount);
+
+            std::vector<vec3> tangents{};
+            sweep(0, sampleCount - 1, tangents);
+        }
+
+        /*
+         * Rebuilds the frames of the given segments after the spline changed there (see spline::setControlPoint).
+         * The frames after a range stay as they are: the twist the new shape adds by the end of a range
+         * is unwound linearly over the range, so the cost depends on the size of the edit, not of the track.
+         */
+        void update(const std::vector<segment_range>& ranges) {
+            int lastSample = (int) poses.size() - 1;
+            std::vector<vec3> tangents{};
+
+            for(const segment_range& range: ranges) {
+                int first = std::max(0, range.first * samplesPerSegment);
+                int last = std::min(range.last * samplesPerSegment, lastSample);
+                if(first >= last) continue;
+
+                vec3 oldEndReference{ references[last] };
+                sweep(first, last, tangents);
+                if(last == lastSample) continue;
+
+                const vec3& endTangent{ tangents.back() };
+                vec3 endReference{ references[last] };
+                double twist = std::atan2(endReference.cross(oldEndReference).dot(endTangent), endReference.dot(oldEndReference));
+
+                for(int i = first + 1; i <= last; i++) {
+                    const vec3& tangent{ tangents[i - first] };
+                    double angle = twist * (i - first) / (last - first);
+                    references[i] = quat::fromAxisAngle(tangent, angle).rotate(references[i]);
+                    setRotation(i, tangent);
+                }
+            }
+        }
+
+        int getSampleCount() const {
+            return poses.size();
+        }
+
+        int getSegmentCount() const {
+            return ((int) poses.size() - 1) / samplesPerSegment;
+        }
+
+        int getSamplesPerSegment() const {
+            return samplesPerSegment;
+        }
+
+        double getSampleU(int index) const {
+            return (double) index / samplesPerSegment;
+        }
+
+        const basic_oriented_pose<T>& getSample(int index) const {
+            return poses.at(index);
+        }
+
+        // u is clamped to [0, getSegmentCount()]
+        basic_oriented_pose<T> getOrientedPose(double u) const {
+            double t;
+            int index = locateSample(u, t);
+            if(t == 0) return poses[index];
+
+            return basic_oriented_pose<T>{ spline->get(u), nlerp(poses[index].rotation, (T) t, poses[index + 1].rotation) };
+        }
+
+        basic_oriented_point<T> getOrientedPoint(double u) const {
+            return getOrientedPose(u).toOrientedPoint();
+        }
+
+    private:
+        const basic_spline<T>* spline;
+        int samplesPerSegment;
+        std::vector<double> roll;
+        std::vector<basic_oriented_pose<T>> poses{};
+        std::vector<vec3> references{};         //the frame up vectors before roll, in double so the propagation does not drift
+
+        // walks the samples first to last and carries the reference of first along, the tangents are written to tangents
+        void sweep(int first, int last, std::vector<vec3>& tangents) {
+            tangents.clear();
+            vec3 lastPosition{};
+
+            basic_spline_stepper<T> it{ spline->stepper((double) first / samplesPerSegment, 1.0 / samplesPerSegment) };
+            for(int i = first; i <= last; i++, it.next()) {
+                vec3 position{ it.getPosition() };
+                vec3 tangent{ it.getTangent() };
+
+                if(i == 0) references[i] = initialReference(tangent);
+                else if(i > first) references[i] = reflect(lastPosition, tangents.back(), references[i - 1], position, tangent);
+
+                poses[i].position = it.getPosition();
+                tangents.push_back(tangent);
+                setRotation(i, tangent);
+
+                lastPosition = position;
+            }
+        }
+
+        void setRotation(int i, const vec3& tangent) {
+            vec3 up{ references[i] };
+            double angle = rollAt(roll, (double) i / samplesPerSegment);
+            if(angle != 0) up = quat::fromAxisAngle(tangent, angle).rotate(up);
+
+            quat rotation{ quat::fromLookRotation(tangent, up) };
+            poses[i].rotation = basic_quat<T>{ (T) rotation.w, (T) rotation.x, (T) rotation.y, (T) rotation.z };
+        }
+
+        // index of the sample at or before u and the progress t towards the next one
+        int locateSample(double u, double& t) const {
+            int lastSample = (int) poses.size() - 1;
+            double sample = u * samplesPerSegment;
+
+            t = 0;
+            if(!(sample > 0)) return 0;
+            if(sample >= lastSample) return lastSample;
+
+            int index = (int) sample;
+            t = sample - index;
+            return index;
+        }
+
+        // the up vector spline::orientedPointFrom would use, the world z axis where the track starts vertical
+        static vec3 initialReference(const vec3& tangent) {
+            vec3 binormal{ tangent.cross(vec3{ 0, 1, 0 }) };
+            if(binormal.length() < 1e-6) binormal = tangent.cross(vec3{ 0, 0, 1 });
+            return tangent.cross(binormal.normalize()).normalize();
+        }
+
+        static vec3 reflect(const vec3& lastPosition, const vec3& lastTangent, const vec3& lastReference, const vec3& position, const vec3& tangent) {
+            vec3 v1{ position - lastPosition };
+            double c1 = v1.dot(v1);
+            vec3 reference{ lastReference };
+            vec3 reflectedTangent{ lastTangent };
+            if(c1 > 0) {
+                reference -= v1 * (2 / c1 * v1.dot(lastReference));
+                reflectedTangent -= v1 * (2 / c1 * v1.dot(lastTangent));
+            }
+
+            vec3 v2{ tangent - reflectedTangent };
+            double c2 = v2.dot(v2);
+            if(c2 > 0) reference -= v2 * (2 / c2 * v2.dot(reference));
+
+            // remove the drift off the tangent plane
+            return (reference - tangent * tangent.dot(reference)).normalize();
+        }
+
+        static double rollAt(const std::vector<double>& roll, double u) {
+            if(roll.empty()) return 0;
+
+            int lastIndex = (int) roll.size() - 1;
+            if(!(u > 0)) return roll.front();
+            if(u >= lastIndex) return roll.back();
+
+            int index = (int) u;
+            double t = u - index;
+            return roll[index] + (roll[index + 1] - roll[index]) * t;
+        }
+    };
+
+    using frame_table = basic_frame_table<double>;
+    using frame_tablef = basic_frame_table<float>;
+}
+
+#endif
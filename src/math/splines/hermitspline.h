@@ -1,64 +1,48 @@
 #ifndef HERMITSPLINE_H
 #define HERMITSPLINE_H
 
-#include "./spline.h"
+#include "./cubicspline.h"
 
 namespace math {
 
-    class hermit_spline : public spline {
+    template<typename T>
+    class basic_hermit_spline : public basic_cubic_spline<T> {
     public:
+        using vector = basic_vec3<T>;
 
-        hermit_spline(std::vector<vec> inControlPoints, std::vector<vec> inVelocities)
-        : spline{inControlPoints}, velocities{ std::move(inVelocities) }
-        { }
-
-        vec get(double u) const { 
-            if(u < 0) return get(0);
-            if(u >= getSegmentCount()) return controlPoints.at(controlPoints.size() - 1);
-
-            int startIndex = (int) std::floor(u); 
-		
-            const vec& startPosition{ controlPoints.at(startIndex) };
-            const vec& startVelocity{ velocities.at(startIndex) };
-            const vec& endPosition{ controlPoints.at(startIndex + 1) };
-            const vec& endVelocity{ velocities.at(startIndex + 1) };
-
-            double t = u;
-            while(t > 1) t -= 1; 
-
-            return (1  * (startPosition) + 
-                    t   * (startVelocity) +
-                    t*t  * (-3 * startPosition - 2 * startVelocity + 3 * endPosition - 1 * endVelocity) + 
-                    t*t*t * (2 * startPosition + startVelocity - 2 * endPosition + endVelocity));
-
+        basic_hermit_spline(std::vector<vector> inControlPoints, std::vector<vector> inVelocities)
+        : basic_cubic_spline<T>{inControlPoints}
+        { 
+            setVelocities(std::move(inVelocities));
         }
 
-        vec getDerivate(double u) const { 
-            if(u < 0) return getDerivate(0);
-            if(u > getSegmentCount()) return getDerivate(getSegmentCount());
-
-            int startIndex = (int) std::floor(u);
-		
-            const vec& startPosition{ controlPoints.at(startIndex) };
-            const vec& startVelocity{ velocities.at(startIndex) };
-            const vec& endPosition{ controlPoints.at(startIndex + 1) };
-            const vec& endVelocity{ velocities.at(startIndex + 1) };
-
-            double t = u;
-            while(t > 1) t -= 1; 
+        // point i is shared by the segments i - 1 and i
+        std::vector<segment_range> setControlPoint(int index, const vector& point) {
+            this->controlPoints.at(index) = point;
+            return { this->updateSegments(index - 1, index + 1) };
+        }
 
-            return (1   * (startVelocity) +
-                    2*t  * (-3 * startPosition - 2 * startVelocity + 3 * endPosition - 1 * endVelocity) + 
-                    3*t*t * (2 * startPosition + startVelocity - 2 * endPosition + endVelocity)).normalize();
+        std::vector<segment_range> setVelocity(int index, const vector& velocity) {
+            velocities.at(index) = velocity;
+            return { this->updateSegments(index - 1, index + 1) };
         }
 
     protected:
-        std::vector<vec> velocities;
+        std::vector<vector> velocities;
 
-        void setVelocities(std::vector<vec> inVelocities) {
+        void setVelocities(std::vector<vector> inVelocities) {
             velocities = std::move(inVelocities);
+            this->rebuildSegments((int) std::min(this->controlPoints.size(), velocities.size()) - 1);
+        }
+
+        cubic_polynomial<T> buildSegment(int segment) const {
+            const std::vector<vector>& controlPoints{ this->controlPoints };
+            return hermite_segment<T>{ controlPoints.at(segment), velocities.at(segment), controlPoints.at(segment + 1), velocities.at(segment + 1) }.toPolynomial();
         }
     };
+
+    using hermit_spline = basic_hermit_spline<double>;
+    using hermit_splinef = basic_hermit_spline<float>;
 };
 
-#endif
\ No newline at end of file
+#endif
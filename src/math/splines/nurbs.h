@@ -0,0 +1,278 @@
+#ifndef NURBS_H
+#define NURBS_H
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "./spline.h"
+
+namespace math {
+
+    /*
+     * Non-uniform rational b-spline of any degree, evaluated with de Boor's algorithm.
+     *
+     * knots needs controlPoints.size() + degree + 1 non-decreasing values, without knots the curve is
+     * clamped uniform (it starts and ends in the first and last control point). Without weights every
+     * point weighs 1 and the curve is a plain non-uniform b-spline.
+     *
+     * Every non-empty knot span is one segment, so u in [i, i + 1] runs through the i-th span like
+     * for the other splines. getByKnot / getDerivateByKnot take the knot parameter of the CAD data
+     * instead. They find the span with a binary search, but try the span of the previous call and the
+     * one after it first, so monotone sweeps (tessellation, car motion) are O(1) per call. The hint makes
+     * those two functions unsafe to call on one nurbs from several threads at once.
+     *
+     * Non-rational curves up to degree 3 also report their spans as cubic_polynomials, so the stepper,
+     * frame tables and bvh take their fast paths.
+     */
+    template<typename T>
+    class basic_nurbs : public basic_spline<T> {
+    public:
+        using vector = basic_vec3<T>;
+
+        basic_nurbs(std::vector<vector> inControlPoints, int inDegree = 3, std::vector<double> inKnots = {}, std::vector<double> inWeights = {})
+        : basic_spline<T>{ std::move(inControlPoints) }, knots{ std::move(inKnots) }, weights{ std::move(inWeights) }
+        {
+            int n = this->controlPoints.size();
+            degree = std::max(1, std::min(inDegree, n - 1));
+
+            if(!knots.empty() && !validKnots()) {
+                std::cerr << "Knot vector needs control points + degree + 1 non-decreasing values, using clamped uniform knots";
+                knots.clear();
+            }
+            if(knots.empty()) knots = clampedUniformKnots(n, degree);
+
+            if(!weights.empty() && (int) weights.size() != n) {
+                std::cerr << "Need one weight per control point, ignoring the weights";
+                weights.clear();
+            }
+            rational = !weights.empty();
+
+            for(int span = degree; span < n && n > degree; span++) {
+                if(knots[span + 1] > knots[span]) spans.push_back(span);
+            }
+
+            if(!rational && degree <= 3) {
+                for(int segment = 0; segment < (int) spans.size(); segment++) polynomials.push_back(buildPolynomial(segment));
+            }
+        }
+
+        int getDegree() const {
+            return degree;
+        }
+
+        const std::vector<double>& getKnots() const {
+            return knots;
+        }
+
+        int getSegmentCount() const {
+            return spans.size();
+        }
+
+        vector get(double u) const {
+            if(spans.empty()) return this->controlPoints.empty()? vector{}: this->controlPoints.front();
+
+            double x;
+            int span = locate(u, x);
+            return vector{ deBoor(span, x, nullptr) };
+        }
+
+        vector getDerivate(double u) const {
+            if(spans.empty()) return vector{};
+
+            double x;
+            int span = locate(u, x);
+            vec3 derivative{};
+            deBoor(span, x, &derivative);
+            return vector{ derivative.normalize() };
+        }
+
+        // x is clamped to the valid knot range [knots[degree], knots[n]]
+        vector getByKnot(double x) const {
+            if(spans.empty()) return get(0);
+            return vector{ deBoor(findSpan(x), clampKnot(x), nullptr) };
+        }
+
+        // dC/dx, not normalized
+        vector getDerivateByKnot(double x) const {
+            if(spans.empty()) return vector{};
+
+            vec3 derivative{};
+            deBoor(findSpan(x), clampKnot(x), &derivative);
+            return vector{ derivative };
+        }
+
+        /*
+         * Point i is part of the knot spans i to i + degree, returns the segments among them
+         * (empty spans have no segment) and rebuilds their polynomials.
+         */
+        std::vector<segment_range> setControlPoint(int index, const vector& point) {
+            this->controlPoints.at(index) = point;
+
+            segment_range range{
+                (int) (std::lower_bound(spans.begin(), spans.end(), index) - spans.begin()),
+                (int) (std::upper_bound(spans.begin(), spans.end(), index + degree) - spans.begin())
+            };
+            if(range.first >= range.last) return {};
+
+            for(int segment = range.first; segment < range.last && segment < (int) polynomials.size(); segment++) polynomials[segment] = buildPolynomial(segment);
+            return { range };
+        }
+
+        // the knots and weights belong to the points, so their number has to stay the same
+        void setControlPoints(std::vector<vector> inControlPoints) {
+            if(inControlPoints.size() != this->controlPoints.size()) {
+                std::cerr << "Need as many control points as before, keeping the old ones";
+                return;
+            }
+
+            this->controlPoints = std::move(inControlPoints);
+            for(int segment = 0; segment < (int) polynomials.size(); segment++) polynomials[segment] = buildPolynomial(segment);
+        }
+
+        bool getSegmentPolynomial(int segment, cubic_polynomial<T>& out) const {
+            if(segment < 0 || segment >= (int) polynomials.size()) return false;
+
+            out = polynomials[segment];
+            return true;
+        }
+
+    private:
+        static constexpr int maxStackDegree = 7;
+
+        int degree = 3;
+        bool rational = false;
+        std::vector<double> knots;
+        std::vector<double> weights;
+        std::vector<int> spans{};                           //knot index of every non-empty span, one per segment
+        std::vector<cubic_polynomial<T>> polynomials{};
+        mutable int lastSpan = 0;                           //index into spans of the previous getByKnot
+
+        // a control point in homogeneous coordinates (p * w, w)
+        struct weighted_point {
+            vec3 p{};
+            double w = 1;
+        };
+
+        bool validKnots() const {
+            if(knots.size() != this->controlPoints.size() + degree + 1) return false;
+            for(int i = 0; i + 1 < (int) knots.size(); i++) {
+                if(knots[i + 1] < knots[i]) return false;
+            }
+            return true;
+        }
+
+        static std::vector<double> clampedUniformKnots(int n, int degree) {
+            std::vector<double> out{};
+            for(int i = 0; i <= degree; i++) out.push_back(0);
+            for(int i = 1; i < n - degree; i++) out.push_back(i);
+            for(int i = 0; i <= degree; i++) out.push_back(std::max(0, n - degree));
+            return out;
+        }
+
+        double clampKnot(double x) const {
+            return std::max(knots[spans.front()], std::min(x, knots[spans.back() + 1]));
+        }
+
+        // knot span of u and the knot parameter x in it
+        int locate(double u, double& x) const {
+            int lastSegment = (int) spans.size() - 1;
+            int segment = 0;
+            double t = 0;
+
+            if(u >= lastSegment + 1) {
+                segment = lastSegment;
+                t = 1;
+            } else if(u > 0) {
+                segment = (int) u;
+                t = u - segment;
+            }
+
+            int span = spans[segment];
+            x = knots[span] + (knots[span + 1] - knots[span]) * t;
+            return span;
+        }
+
+        // the span containing x, the end of the range belongs to the last span
+        int findSpan(double x) const {
+            auto contains = [&](int index) {
+                int span = spans[index];
+                bool last = index + 1 == (int) spans.size();
+                return knots[span] <= x && (x < knots[span + 1] || last);
+            };
+
+            if(contains(lastSpan)) return spans[lastSpan];
+            if(lastSpan + 1 < (int) spans.size() && contains(lastSpan + 1)) return spans[++lastSpan];
+
+            auto byStart = [&](double value, int span) { return value < knots[span]; };
+            int index = (int) (std::upper_bound(spans.begin(), spans.end(), x, byStart) - spans.begin()) - 1;
+            lastSpan = std::max(0, index);
+            return spans[lastSpan];
+        }
+
+        weighted_point weighted(int i) const {
+            double w = rational? weights[i]: 1;
+            return weighted_point{ vec3{ this->controlPoints[i] } * w, w };
+        }
+
+        /*
+         * de Boor's algorithm on the homogeneous points d_0 .. d_degree of span k:
+         *  d_j = (1 - a) d_(j-1) + a d_j,  a = (x - t_(j+k-degree)) / (t_(j+1+k-r) - t_(j+k-degree)),  r = 1 .. degree
+         * The derivative comes from the second to last level, C' = (A' - w' C) / w for rational curves.
+         */
+        vec3 deBoor(int k, double x, vec3* derivative) const {
+            weighted_point stackBuffer[maxStackDegree + 1];
+            std::vector<weighted_point> heapBuffer{};
+            weighted_point* d = stackBuffer;
+            if(degree > maxStackDegree) {
+                heapBuffer.resize(degree + 1);
+                d = heapBuffer.data();
+            }
+
+            for(int j = 0; j <= degree; j++) d[j] = weighted(j + k - degree);
+
+            weighted_point beforeLast[2]{};
+            for(int r = 1; r <= degree; r++) {
+                if(r == degree) {
+                    beforeLast[0] = d[degree - 1];
+                    beforeLast[1] = d[degree];
+                }
+
+                for(int j = degree; j >= r; j--) {
+                    double start = knots[j + k - degree];
+                    double a = (x - start) / (knots[j + 1 + k - r] - start);
+                    d[j].p = d[j - 1].p * (1 - a) + d[j].p * a;
+                    d[j].w = d[j - 1].w * (1 - a) + d[j].w * a;
+                }
+            }
+
+            vec3 position{ d[degree].p / d[degree].w };
+            if(derivative) {
+                double scale = degree / (knots[k + 1] - knots[k]);
+                vec3 a{ (beforeLast[1].p - beforeLast[0].p) * scale };
+                double w = (beforeLast[1].w - beforeLast[0].w) * scale;
+                *derivative = (a - position * w) / d[degree].w;
+            }
+            return position;
+        }
+
+        // power basis of a span from 4 samples, exact for the polynomial spans of degree <= 3
+        cubic_polynomial<T> buildPolynomial(int segment) const {
+            int span = spans[segment];
+            vec3 f[4];
+            for(int i = 0; i < 4; i++) f[i] = deBoor(span, knots[span] + (knots[span + 1] - knots[span]) * i / 3.0, nullptr);
+
+            return cubic_polynomial<T>{{
+                vector{ f[0] },
+                vector{ (f[0] * -11 + f[1] * 18 - f[2] * 9 + f[3] * 2) / 2.0 },
+                vector{ (f[0] * 2 - f[1] * 5 + f[2] * 4 - f[3]) * 4.5 },
+                vector{ (f[1] * 3 - f[0] - f[2] * 3 + f[3]) * 4.5 }
+            }};
+        }
+    };
+
+    using nurbs = basic_nurbs<double>;
+    using nurbsf = basic_nurbs<float>;
+}
+
+#endif
@@ -6,11 +6,22 @@
 #include <algorithm>
 
 #include "raylib.h"
-#include "../vector.h"
+#include "../vec3.h"
+#include "../mat3.h"
 #include "../../point.h"
+#include "./cubicsegment.h"
 
 namespace math {
 
+    template<typename T>
+    class basic_spline_stepper;
+
+    // the segments first to last - 1
+    struct segment_range {
+        int first = 0;
+        int last = 0;
+    };
+
     /*
      * Given a series of n points, that form a path
      *
@@ -28,54 +39,105 @@ namespace math {
      * 
      * The path from one point to the next is called a segment. Ex p1-p2
      * t-values denote the progress on a segment.
+     *
+     * T is the precision of the points, u stays a double for both.
+     * spline (double) is meant for the simulation, splinef (float) for tessellation and rendering.
+     * On our track suite (up to 1000 points) splinef stays within 4e-7 * track size of the double
+     * positions and within 1.5e-4 rad of the double frames, the worst case being near vertical
+     * tangents. See src/bench/precisionbench.cpp.
      */
-    class spline {
+    template<typename T>
+    class basic_spline {
     public:
+        using scalar = T;
+        using vector = basic_vec3<T>;
 
-        spline(std::vector<vec> inControlPoints) 
+        basic_spline(std::vector<vector> inControlPoints) 
         :controlPoints{ std::move(inControlPoints) }
         { }
 
-        oriented_point getOrientedPoint(double u) const {
-            vec point{ get(u) };
+        virtual ~basic_spline() = default;
+
+        basic_oriented_point<T> getOrientedPoint(double u) const {
+            return orientedPointFrom(get(u), getDerivate(u));
+        }
+
+        // builds the frame at a point from the (normalized) tangent and the world up axis
+        static basic_oriented_point<T> orientedPointFrom(const vector& point, const vector& tangent) {
+            vector binormal{ tangent.cross(vector{ 0, 1, 0 }).normalize() };
+            vector normal{ tangent.cross(binormal).normalize() };
+
+            basic_mat3<T> orientation{ lookRotation(tangent, normal) };
+            return basic_oriented_point<T>{ point, orientation };
+        }
+
+        basic_oriented_pose<T> getOrientedPose(double u) const {
+            return basic_oriented_pose<T>::fromOrientedPoint(getOrientedPoint(u));
+        }
+
+        /*
+         * Position and (normalized) tangent for every u in us, written in SoA layout.
+         * Same values as calling get and getDerivate for each u, but the segment is looked up
+         * only once per sample and the cubic splines evaluate several samples per SIMD instruction.
+         * positions and tangents are resized to us.size(), pass the same arrays every frame to reuse their memory.
+         */
+        void evaluate(const std::vector<double>& us, basic_vec3_array<T>& positions, basic_vec3_array<T>& tangents) const {
+            positions.resize(us.size());
+            tangents.resize(us.size());
+            evaluateSamples(us.data(), us.size(), positions, tangents);
+        }
+
+        // also builds the frame of every sample, like getOrientedPoint does
+        void evaluate(const std::vector<double>& us, basic_vec3_array<T>& positions, basic_vec3_array<T>& tangents, std::vector<basic_oriented_point<T>>& frames) const {
+            evaluate(us, positions, tangents);
 
-            vec tangent{ getDerivate(u) };
-            vec binormal{ tangent.cross(vec::vec3d(0, 1, 0)).normalize() };
-            vec normal{ tangent.cross(binormal).normalize() };
+            frames.clear();
+            frames.reserve(us.size());
+            for(int i = 0; i < (int) us.size(); i++) frames.push_back(orientedPointFrom(positions.get(i), tangents.get(i)));
+        }
+
+        // walks the spline from u0 in steps of du, see basic_spline_stepper
+        basic_spline_stepper<T> stepper(double u0, double du) const;
+
+        const std::vector<vector>& getControlPoints() const {
+            return controlPoints;
+        }
 
-            matrix orientation{ lookRotation(tangent, normal) };
-            return oriented_point{ point, orientation };
+        /*
+         * Moves one control point and recomputes only what depends on it.
+         * Returns the segments whose shape changed (at most two ranges, a closed spline wraps around),
+         * hand them to frame_table::update and track_mesh::update.
+         */
+        virtual std::vector<segment_range> setControlPoint(int index, const vector& point) {
+            controlPoints.at(index) = point;
+            return { segment_range{ std::max(0, index - 1), std::min(index + 1, getSegmentCount()) } };
         }
 
-        virtual vec get(double u) const { 
+        virtual vector get(double u) const { 
             if(u < 0) return get(0);
-            if(u >= getSegmentCount()) return get(getSegmentCount());
+            if(u >= getSegmentCount()) return controlPoints.back();
 
-            int startIndex = (int) std::floor(u);
-            vec start = controlPoints.at(startIndex);
-            vec end = controlPoints.at(startIndex + 1);
+            int startIndex = (int) u;
+            vector start = controlPoints.at(startIndex);
+            vector end = controlPoints.at(startIndex + 1);
             
-            double t = u;
-            while(t > 1) t -= 1;
-
-            return vec{ start}  + (end - start) * t;
+            double t = u - startIndex;
+            return vector{ start}  + (end - start) * t;
         }
 
-        virtual vec getDerivate(double u) const { 
+        virtual vector getDerivate(double u) const { 
+            if(getSegmentCount() <= 0) return vector{};     //a single point has no direction
             if(u < 0) return getDerivate(0);
-            if(u > getSegmentCount()) return getDerivate(getSegmentCount());
+            if(u >= getSegmentCount()) return getDerivate(getSegmentCount() - 1);
 
-            int startIndex = (int) std::floor(u);
-            vec start = controlPoints.at(startIndex);
-            vec end = controlPoints.at(startIndex + 1);
-            
-            double t = u;
-            while(t > 1) t -= 1;
+            int startIndex = (int) u;
+            vector start = controlPoints.at(startIndex);
+            vector end = controlPoints.at(startIndex + 1);
 
             return ((end - start)).normalize();
         }
 
-        vec operator()(double u) const {
+        vector operator()(double u) const {
             return get(u);
         }
 
@@ -83,14 +145,21 @@ namespace math {
             return controlPoints.size() - 1;
         }
 
+        // the power basis form of a segment, false if the spline is not piecewise cubic
+        virtual bool getSegmentPolynomial(int segment, cubic_polynomial<T>& out) const {
+            return false;
+        }
+
+        // chord length at a fixed sample rate, see basic_arclength_table for the exact length and distance <-> u lookups
         double estimateLength(double sampleRate = 0.05, double lastU = -1) const {   
             if(lastU < 0) lastU = getSegmentCount();
             double length = 0;
 
-            vec last{ get(0) };
-            for(double u = sampleRate; u < lastU; u++) {
-                vec current{ get(u) };
+            vector last{ get(0) };
+            for(double u = sampleRate; u < lastU; u += sampleRate) {
+                vector current{ get(u) };
                 length += current.distanceTo(last);
+                last = current;
             }
             length += last.distanceTo(get(lastU));
 
@@ -98,15 +167,183 @@ namespace math {
         }
 
     protected:
-        std::vector<vec> controlPoints{};
+        std::vector<vector> controlPoints{};
 
-        void setControlPoints(std::vector<vec> inControlPoints) {
+        // fills index 0 to count - 1 of the (already resized) outputs
+        virtual void evaluateSamples(const double* us, int count, basic_vec3_array<T>& positions, basic_vec3_array<T>& tangents) const {
+            for(int i = 0; i < count; i++) {
+                positions.set(i, get(us[i]));
+                tangents.set(i, getDerivate(us[i]));
+            }
+        }
+
+        void setControlPoints(std::vector<vector> inControlPoints) {
             controlPoints = std::move(inControlPoints);
         }
 
     private:
 
     };
+
+    using spline = basic_spline<double>;
+    using splinef = basic_spline<float>;
+
+    /*
+     * Evaluates a spline at u0, u0 + du, u0 + 2du, ... (du may be negative).
+     *
+     * Inside a segment the cubic is advanced with forward differences, a step costs a few
+     * additions instead of a full evaluation. Whenever a step crosses into another segment
+     * (or leaves [0, getSegmentCount()]) the stepper resyncs with an exact evaluation, so
+     * errors never carry over from one segment to the next.
+     * The differences are accumulated in double, also for splinef, to keep the drift far below float precision.
+     * Splines that are not piecewise cubic fall back to get and getDerivate on every step.
+     *
+     *  for(auto it = s.stepper(0, 0.01); it.getU() <= s.getSegmentCount(); it.next()) {
+     *      oriented_pointf p{ it.getOrientedPoint() };
+     *  }
+     */
+    template<typename T>
+    class basic_spline_stepper {
+    public:
+        using vector = basic_vec3<T>;
+
+        basic_spline_stepper(const basic_spline<T>& inSpline, double inU0, double inDu)
+        : spline{ &inSpline }, u0{ inU0 }, du{ inDu }, u{ inU0 }, segmentCount{ inSpline.getSegmentCount() },
+          state{ resync(inSpline, segmentCount, inU0, inDu) }
+        { }
+
+        basic_spline_stepper& next() {
+            step++;
+            u = u0 + step * du;
+
+            if(!(u > state.segmentStart && u < state.segmentEnd)) {
+                state = resync(*spline, segmentCount, u, du);
+                return *this;
+            }
+
+            for(int i = 0; i < 4; i++) {
+                state.position[i] += state.positionDifferences[0][i];
+                state.positionDifferences[0][i] += state.positionDifferences[1][i];
+                state.positionDifferences[1][i] += state.positionDifferences[2][i];
+
+                state.velocity[i] += state.velocityDifferences[0][i];
+                state.velocityDifferences[0][i] += state.velocityDifferences[1][i];
+            }
+            return *this;
+        }
+
+        double getU() const {
+            return u;
+        }
+
+        vector getPosition() const {
+            return vector{ (T) state.position[0], (T) state.position[1], (T) state.position[2] };
+        }
+
+        // normalized, like spline::getDerivate
+        vector getTangent() const {
+            return vector{ (T) state.velocity[0], (T) state.velocity[1], (T) state.velocity[2] }.normalize();
+        }
+
+        basic_oriented_point<T> getOrientedPoint() const {
+            return basic_spline<T>::orientedPointFrom(getPosition(), getTangent());
+        }
+
+    private:
+        /*
+         * Everything the steps update, x, y, z plus a padding lane so the additions map onto whole
+         * SIMD registers. resync returns it by value instead of writing through this, that way the
+         * compiler can keep a stepper that lives in a loop entirely in registers.
+         */
+        struct differences {
+            // the open u range the differences are valid for, empty when every step is a full evaluation
+            double segmentStart = 0;
+            double segmentEnd = 0;
+
+            double position[4]{};
+            double velocity[4]{};
+            double positionDifferences[3][4]{};
+            double velocityDifferences[2][4]{};
+        };
+
+        const basic_spline<T>* spline;
+        double u0;
+        double du;
+        double u;
+        int segmentCount;
+        long step = 0;
+        differences state;
+
+        static void store(const vec3& v, double* out) {
+            out[0] = v.x;
+            out[1] = v.y;
+            out[2] = v.z;
+            out[3] = 0;
+        }
+
+        // exact evaluation at u, then the differences for the following steps
+        static differences resync(const basic_spline<T>& spline, int segmentCount, double u, double du) {
+            differences out{};
+            cubic_polynomial<T> polynomial{};
+            int segment = std::max(0, std::min((int) u, segmentCount - 1));
+
+            if(!(u > 0 && u < segmentCount && spline.getSegmentPolynomial(segment, polynomial))) {
+                store(vec3{ spline.get(u) }, out.position);
+                store(vec3{ spline.getDerivate(u) }, out.velocity);
+                return out;
+            }
+
+            // integer u belong to the next segment, so the start is excluded as well
+            out.segmentStart = segment;
+            out.segmentEnd = segment + 1;
+
+            vec3 c0{ polynomial.coefficients[0] };
+            vec3 c1{ polynomial.coefficients[1] };
+            vec3 c2{ polynomial.coefficients[2] };
+            vec3 c3{ polynomial.coefficients[3] };
+            double t = u - segment;
+            double h = du;
+
+            store(((c3 * t + c2) * t + c1) * t + c0, out.position);
+            store(c1 * h + c2 * (2 * t * h + h * h) + c3 * (3 * t * t * h + 3 * t * h * h + h * h * h), out.positionDifferences[0]);
+            store(c2 * (2 * h * h) + c3 * (6 * t * h * h + 6 * h * h * h), out.positionDifferences[1]);
+            store(c3 * (6 * h * h * h), out.positionDifferences[2]);
+
+            store((c3 * (3 * t) + c2 * 2) * t + c1, out.velocity);
+            store(c2 * (2 * h) + c3 * (6 * t * h + 3 * h * h), out.velocityDifferences[0]);
+            store(c3 * (6 * h * h), out.velocityDifferences[1]);
+            return out;
+        }
+    };
+
+    using spline_stepper = basic_spline_stepper<double>;
+    using spline_stepperf = basic_spline_stepper<float>;
+
+    template<typename T>
+    basic_spline_stepper<T> basic_spline<T>::stepper(double u0, double du) const {
+        return basic_spline_stepper<T>{ *this, u0, du };
+    }
+
+    /*
+     * Compile time counterparts of spline::get, getDerivate and getOrientedPoint.
+     * They call the functions of the concrete spline type directly (qualified calls are not
+     * dispatched through the vtable), so the cubic_segment kernels get inlined.
+     * Use them where the spline type is known, e.g. getOrientedPoint(catmullromSpline, u).
+     */
+    template<typename Spline>
+    typename Spline::vector get(const Spline& s, double u) {
+        return s.Spline::get(u);
+    }
+
+    template<typename Spline>
+    typename Spline::vector getDerivate(const Spline& s, double u) {
+        return s.Spline::getDerivate(u);
+    }
+
+    template<typename Spline>
+    basic_oriented_point<typename Spline::scalar> getOrientedPoint(const Spline& s, double u) {
+        return Spline::orientedPointFrom(s.Spline::get(u), s.Spline::getDerivate(u));
+    }
 }
 
 #endif
\ No newline at end of file
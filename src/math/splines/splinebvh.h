@@ -0,0 +1,273 @@
+#ifndef SPLINEBVH_H
+#define SPLINEBVH_H
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include "./spline.h"
+
+namespace math {
+
+    template<typename T>
+    struct basic_closest_point {
+        using vector = basic_vec3<T>;
+
+        double u = 0;
+        double distance = std::numeric_limits<double>::infinity();
+        vector position{};
+    };
+
+    using closest_point = basic_closest_point<double>;
+    using closest_pointf = basic_closest_point<float>;
+
+    /*
+     * Bounding volume hierarchy over the segments of a spline, for going from a world position back to u.
+     *
+     * For piecewise cubic splines the box of a segment is the box of its 4 bezier control points,
+     * which contain the segment (convex hull property). Other splines get the box of 17 samples per
+     * segment, which can miss a bulge between two samples.
+     *
+     * closestPoint walks the tree nearest box first and skips every box farther away than the best
+     * point found so far. Inside a segment the closest point is found with Newton's method on
+     * (p(t) - point) . p'(t) = 0, started once in every quarter of the segment.
+     * The segments are copied at construction, rebuild the bvh after the spline changed.
+     */
+    template<typename T>
+    class basic_spline_bvh {
+    public:
+        using vector = basic_vec3<T>;
+        using result = basic_closest_point<T>;
+
+        basic_spline_bvh(const basic_spline<T>& inSpline)
+        : spline{ &inSpline }
+        {
+            int segmentCount = inSpline.getSegmentCount();
+
+            cubic = segmentCount > 0;
+            for(int i = 0; i < segmentCount; i++) {
+                cubic_polynomial<T> polynomial{};
+                if(!inSpline.getSegmentPolynomial(i, polynomial)) {
+                    cubic = false;
+                    break;
+                }
+                polynomials.push_back(toDouble(polynomial));
+            }
+            if(!cubic) polynomials.clear();
+
+            std::vector<leaf> leaves{};
+            for(int i = 0; i < segmentCount; i++) leaves.push_back(leaf{ i, segmentBox(i) });
+
+            nodes.reserve(std::max(0, 2 * segmentCount - 1));
+            if(segmentCount > 0) build(leaves, 0, segmentCount);
+        }
+
+        // closest point on the whole spline, u in [0, getSegmentCount()]
+        result closestPoint(const vector& point) const {
+            result best{};
+            if(nodes.empty()) return best;
+
+            search(vec3{ point }, best);
+            return best;
+        }
+
+        /*
+         * One closestPoint per point. The answer of the previous point is a point on the spline too,
+         * its distance to the next point bounds the search from the start. For coherent points
+         * (cars, a drag in the editor, a row of vertices) that skips most boxes straight away.
+         */
+        void closestPoints(const std::vector<vector>& points, std::vector<result>& out) const {
+            out.clear();
+            out.reserve(points.size());
+            if(nodes.empty()) {
+                out.resize(points.size());
+                return;
+            }
+
+            for(const vector& p: points) {
+                vec3 point{ p };
+                result best{};
+                if(!out.empty()) best = result{ out.back().u, (vec3{ out.back().position } - point).length(), out.back().position };
+
+                search(point, best);
+                out.push_back(best);
+            }
+        }
+
+    private:
+        struct box {
+            vec3 min{ std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity() };
+            vec3 max{ -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() };
+
+            void add(const vec3& p) {
+                for(int i = 0; i < 3; i++) {
+                    min[i] = std::min(min[i], p[i]);
+                    max[i] = std::max(max[i], p[i]);
+                }
+            }
+
+            void add(const box& b) {
+                add(b.min);
+                add(b.max);
+            }
+
+            vec3 center() const {
+                return (min + max) * 0.5;
+            }
+
+            double distanceSquaredTo(const vec3& p) const {
+                double out = 0;
+                for(int i = 0; i < 3; i++) {
+                    double d = std::max({ min[i] - p[i], 0.0, p[i] - max[i] });
+                    out += d * d;
+                }
+                return out;
+            }
+        };
+
+        struct leaf {
+            int segment;
+            box bounds;
+        };
+
+        // a leaf when segment >= 0, otherwise the children are at index + 1 and right
+        struct node {
+            box bounds;
+            int segment = -1;
+            int right = -1;
+        };
+
+        const basic_spline<T>* spline;
+        bool cubic;
+        std::vector<cubic_polynomial<double>> polynomials{};
+        std::vector<node> nodes{};
+
+        static cubic_polynomial<double> toDouble(const cubic_polynomial<T>& polynomial) {
+            cubic_polynomial<double> out{};
+            for(int i = 0; i < 4; i++) out.coefficients[i] = vec3{ polynomial.coefficients[i] };
+            return out;
+        }
+
+        box segmentBox(int segment) const {
+            box out{};
+            if(cubic) {
+                // power basis to bezier control points
+                const vec3* c = polynomials[segment].coefficients;
+                out.add(c[0]);
+                out.add(c[0] + c[1] / 3.0);
+                out.add(c[0] + c[1] * (2 / 3.0) + c[2] / 3.0);
+                out.add(c[0] + c[1] + c[2] + c[3]);
+                return out;
+            }
+
+            for(int i = 0; i <= 16; i++) out.add(vec3{ spline->get(segment + i / 16.0) });
+            return out;
+        }
+
+        // top down, split at the median of the box centers along the longest axis
+        int build(std::vector<leaf>& leaves, int first, int last) {
+            int index = nodes.size();
+            nodes.push_back(node{});
+
+            box bounds{};
+            box centers{};
+            for(int i = first; i < last; i++) {
+                bounds.add(leaves[i].bounds);
+                centers.add(leaves[i].bounds.center());
+            }
+            nodes[index].bounds = bounds;
+
+            if(last - first == 1) {
+                nodes[index].segment = leaves[first].segment;
+                return index;
+            }
+
+            vec3 extent{ centers.max - centers.min };
+            int axis = extent.x > extent.y? (extent.x > extent.z? 0: 2): (extent.y > extent.z? 1: 2);
+
+            int middle = (first + last) / 2;
+            std::nth_element(leaves.begin() + first, leaves.begin() + middle, leaves.begin() + last,
+                [axis](const leaf& a, const leaf& b) { return a.bounds.center()[axis] < b.bounds.center()[axis]; });
+
+            build(leaves, first, middle);
+            nodes[index].right = build(leaves, middle, last);
+            return index;
+        }
+
+        void search(const vec3& point, result& best) const {
+            double bestSquared = best.distance * best.distance;
+
+            int stack[64];
+            int top = 0;
+            stack[top++] = 0;
+
+            while(top > 0) {
+                const node& n{ nodes[stack[--top]] };
+                if(n.bounds.distanceSquaredTo(point) >= bestSquared) continue;
+
+                if(n.segment >= 0) {
+                    refine(n.segment, point, best);
+                    bestSquared = best.distance * best.distance;
+                    continue;
+                }
+
+                // push the farther child first so the nearer one is searched first
+                int left = &n - nodes.data() + 1;
+                int right = n.right;
+                bool leftFirst = nodes[left].bounds.distanceSquaredTo(point) <= nodes[right].bounds.distanceSquaredTo(point);
+                stack[top++] = leftFirst? right: left;
+                stack[top++] = leftFirst? left: right;
+            }
+        }
+
+        // closest point on one segment, replaces best when it is closer
+        void refine(int segment, const vec3& point, result& best) const {
+            // the distance can have several local minima on a segment, so every quarter gets its own start
+            for(int i = 0; i < 4; i++) {
+                double t = cubic? newton(polynomials[segment], point, (i + 0.5) / 4): ternarySearch(segment, point, i / 4.0, (i + 1) / 4.0);
+
+                vec3 position{ positionAt(segment, t) };
+                double distance = (position - point).length();
+                if(distance < best.distance) best = result{ segment + t, distance, vector{ position } };
+            }
+        }
+
+        // solves (p(t) - point) . p'(t) = 0, t stays in [0, 1]
+        static double newton(const cubic_polynomial<double>& p, const vec3& point, double t) {
+            for(int i = 0; i < 8; i++) {
+                vec3 offset{ p.get(t) - point };
+                vec3 velocity{ p.getVelocity(t) };
+                vec3 acceleration{ p.coefficients[2] * 2 + p.coefficients[3] * (6 * t) };
+
+                double slope = offset.dot(velocity);
+                double curvature = velocity.dot(velocity) + offset.dot(acceleration);
+                double step = curvature > 0? slope / curvature: (slope > 0? 0.125: -0.125);
+
+                double next = std::max(0.0, std::min(t - step, 1.0));
+                if(std::abs(next - t) < 1e-12) return next;
+                t = next;
+            }
+            return t;
+        }
+
+        double ternarySearch(int segment, const vec3& point, double low, double high) const {
+            for(int i = 0; i < 30; i++) {
+                double a = low + (high - low) / 3;
+                double b = high - (high - low) / 3;
+                if((positionAt(segment, a) - point).lengthSquared() < (positionAt(segment, b) - point).lengthSquared()) high = b;
+                else low = a;
+            }
+            return (low + high) / 2;
+        }
+
+        vec3 positionAt(int segment, double t) const {
+            if(cubic) return polynomials[segment].get(t);
+            return vec3{ spline->get(segment + t) };
+        }
+    };
+
+    using spline_bvh = basic_spline_bvh<double>;
+    using spline_bvhf = basic_spline_bvh<float>;
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef TESSELLATION_H
+#define TESSELLATION_H
+
+#include <vector>
+#include <algorithm>
+
+#include "./frametable.h"
+
+namespace math {
+
+    /*
+     * Picks the edgeloops extrude() builds the track mesh from.
+     *
+     * tessellateUniform takes every sample of a frame table. tessellateAdaptive starts with
+     * minSamplesPerSegment loops per segment and halves an interval until the spline stays within
+     * maxChordDeviation of the straight line between its loops and the frames of both loops are at
+     * most maxFrameAngle (radians) apart, so straights get few loops and tight or twisting parts many.
+     */
+    struct tessellation_tolerance {
+        double maxChordDeviation = 0.005;
+        double maxFrameAngle = 0.05;
+        int minSamplesPerSegment = 4;
+        int maxDepth = 10;
+    };
+
+    // what came out, the errors are measured on the result (between loops), not estimated
+    struct tessellation_report {
+        int edgeLoops = 0;
+        double chordDeviation = 0;
+        double frameAngle = 0;
+    };
+
+    namespace tessellation {
+
+        // angle of the rotation between two unit quaternions
+        template<typename T>
+        double angleBetween(const basic_quat<T>& a, const basic_quat<T>& b) {
+            double cosHalfAngle = std::min(1.0, (double) std::abs(a.dot(b)));
+            return 2 * std::acos(cosHalfAngle);
+        }
+
+        template<typename T>
+        double distanceToChord(const basic_vec3<T>& point, const basic_vec3<T>& start, const basic_vec3<T>& end) {
+            vec3 chord{ end - start };
+            vec3 offset{ point - start };
+            double lengthSquared = chord.dot(chord);
+
+            double t = lengthSquared > 0? std::max(0.0, std::min(offset.dot(chord) / lengthSquared, 1.0)): 0;
+            return (offset - chord * t).length();
+        }
+
+        // largest deviation of the spline from the chord between the loops at startU and endU, checked at the quarter points
+        template<typename T>
+        double chordDeviation(const basic_frame_table<T>& frames, double startU, const basic_vec3<T>& start, double endU, const basic_vec3<T>& end) {
+            double deviation = 0;
+            for(int i = 1; i < 4; i++) {
+                double u = startU + (endU - startU) * i / 4;
+                deviation = std::max(deviation, distanceToChord(frames.getOrientedPose(u).position, start, end));
+            }
+            return deviation;
+        }
+
+        template<typename T>
+        void refine(const basic_frame_table<T>& frames, const tessellation_tolerance& tolerance, int depth,
+                    double startU, const basic_oriented_pose<T>& start, double endU, const basic_oriented_pose<T>& end,
+                    std::vector<basic_oriented_pose<T>>& edgeLoops, std::vector<double>& us) {
+            bool fine = depth >= tolerance.maxDepth ||
+                (angleBetween(start.rotation, end.rotation) <= tolerance.maxFrameAngle &&
+                 chordDeviation(frames, startU, start.position, endU, end.position) <= tolerance.maxChordDeviation);
+
+            if(!fine) {
+                double middleU = (startU + endU) / 2;
+                basic_oriented_pose<T> middle{ frames.getOrientedPose(middleU) };
+
+                refine(frames, tolerance, depth + 1, startU, start, middleU, middle, edgeLoops, us);
+                refine(frames, tolerance, depth + 1, middleU, middle, endU, end, edgeLoops, us);
+                return;
+            }
+
+            edgeLoops.push_back(end);
+            us.push_back(endU);
+        }
+
+        template<typename T>
+        tessellation_report measure(const basic_frame_table<T>& frames, const std::vector<basic_oriented_pose<T>>& edgeLoops, const std::vector<double>& us) {
+            tessellation_report out{};
+            out.edgeLoops = edgeLoops.size();
+
+            for(int i = 0; i + 1 < (int) edgeLoops.size(); i++) {
+                out.chordDeviation = std::max(out.chordDeviation, chordDeviation(frames, us[i], edgeLoops[i].position, us[i + 1], edgeLoops[i + 1].position));
+                out.frameAngle = std::max(out.frameAngle, angleBetween(edgeLoops[i].rotation, edgeLoops[i + 1].rotation));
+            }
+            return out;
+        }
+    }
+
+    // one edgeloop per sample of the frame table, edgeLoops is cleared first
+    template<typename T>
+    tessellation_report tessellateUniform(const basic_frame_table<T>& frames, std::vector<basic_oriented_pose<T>>& edgeLoops) {
+        edgeLoops.clear();
+        std::vector<double> us{};
+
+        for(int i = 0; i < frames.getSampleCount(); i++) {
+            edgeLoops.push_back(frames.getSample(i));
+            us.push_back(frames.getSampleU(i));
+        }
+        return tessellation::measure(frames, edgeLoops, us);
+    }
+
+    // edgeLoops is cleared first
+    template<typename T>
+    tessellation_report tessellateAdaptive(const basic_frame_table<T>& frames, const tessellation_tolerance& tolerance, std::vector<basic_oriented_pose<T>>& edgeLoops) {
+        edgeLoops.clear();
+        std::vector<double> us{};
+        if(frames.getSampleCount() == 0) return tessellation_report{};
+
+        int intervals = frames.getSegmentCount() * std::max(1, tolerance.minSamplesPerSegment);
+        double maxU = frames.getSegmentCount();
+
+        basic_oriented_pose<T> start{ frames.getOrientedPose(0) };
+        edgeLoops.push_back(start);
+        us.push_back(0);
+
+        for(int i = 0; i < intervals; i++) {
+            double startU = maxU * i / intervals;
+            double endU = maxU * (i + 1) / intervals;
+            basic_oriented_pose<T> end{ frames.getOrientedPose(endU) };
+
+            tessellation::refine(frames, tolerance, 0, startU, start, endU, end, edgeLoops, us);
+            start = end;
+        }
+        return tessellation::measure(frames, edgeLoops, us);
+    }
+}
+
+#endif
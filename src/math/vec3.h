@@ -0,0 +1,256 @@
+#ifndef VEC3_H
+#define VEC3_H
+
+#include <iostream>
+#include <math.h>
+#include <vector>
+
+#include "raylib.h"
+#include "vector.h"
+
+namespace math {
+
+    /*
+     * Dense 3 component vector with its values stored inline.
+     * Used on the hot paths (splines, frames) instead of the map backed vec.
+     *
+     * T is the precision, vec3 (double) is meant for simulation and
+     * vec3f (float) for tessellation and rendering.
+     */
+    template<typename T>
+    struct basic_vec3 {
+        using scalar = T;
+
+        T x{};
+        T y{};
+        T z{};
+
+    //> Constructors
+    constexpr basic_vec3() = default;
+
+    constexpr basic_vec3(T inX, T inY, T inZ)
+    : x{ inX }, y{ inY }, z{ inZ }
+    { }
+
+    template<typename U>
+    constexpr explicit basic_vec3(const basic_vec3<U>& v)
+    : x{ (T) v.x }, y{ (T) v.y }, z{ (T) v.z }
+    { }
+
+    explicit basic_vec3(const vec& v)
+    : x{ (T) v.get(0) }, y{ (T) v.get(1) }, z{ (T) v.get(2) }
+    { }
+
+    explicit basic_vec3(const Vector3& v)
+    : x{ (T) v.x }, y{ (T) v.y }, z{ (T) v.z }
+    { }
+
+    static constexpr basic_vec3 zero() {
+        return basic_vec3{ 0, 0, 0 };
+    }
+
+    //> Setters
+    basic_vec3& set(int index, T value) {
+        (*this)[index] = value;
+        return *this;
+    }
+
+    //> Getters
+    T get(int index) const {
+        return (*this)[index];
+    }
+
+    T& operator[](int index) {
+        return index == 0? x: index == 1? y: z;
+    }
+
+    T operator[](int index) const {
+        return index == 0? x: index == 1? y: z;
+    }
+
+    //> Properties
+    constexpr int getDimension() const {
+        return 3;
+    }
+
+    //> Operations
+    T length() const {
+        return std::sqrt(x * x + y * y + z * z);
+    }
+
+    constexpr T lengthSquared() const {
+        return x * x + y * y + z * z;
+    }
+
+    constexpr T dot(const basic_vec3& v2) const {
+        return x * v2.x + y * v2.y + z * v2.z;
+    }
+
+    constexpr basic_vec3 cross(const basic_vec3& v2) const {
+        return basic_vec3{
+            y * v2.z - z * v2.y,
+            z * v2.x - x * v2.z,
+            x * v2.y - y * v2.x
+        };
+    }
+
+    basic_vec3& normalize(T wantedLength = 1) {
+        T length = (*this).length();
+        if(length == 0) {
+            x = y = z = 0;
+            return *this;
+        }
+
+        T factor = wantedLength / length;
+        x *= factor;
+        y *= factor;
+        z *= factor;
+        return *this;
+    }
+
+    basic_vec3 normalize(T wantedLength = 1) const {
+        basic_vec3 out{ *this };
+        out.normalize(wantedLength);
+        return out;
+    }
+
+    T distanceTo(const basic_vec3& v2) const {
+        T dx = v2.x - x;
+        T dy = v2.y - y;
+        T dz = v2.z - z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    constexpr basic_vec3& operator+=(const basic_vec3& v2) {
+        x += v2.x; y += v2.y; z += v2.z;
+        return *this;
+    }
+
+    constexpr basic_vec3& operator-=(const basic_vec3& v2) {
+        x -= v2.x; y -= v2.y; z -= v2.z;
+        return *this;
+    }
+
+    constexpr basic_vec3& operator*=(T value) {
+        x *= value; y *= value; z *= value;
+        return *this;
+    }
+
+    constexpr basic_vec3& operator/=(T value) {
+        x /= value; y /= value; z /= value;
+        return *this;
+    }
+
+    //> Export
+    vec toVec() const {
+        return vec::vec3d(x, y, z);
+    }
+
+    std::vector<T> toList() const {
+        return { x, y, z };
+    }
+
+    Vector3 toVector3() const {
+        return Vector3{ (float) x, (float) y, (float) z };
+    }
+
+    //> More Operators
+    // defined as friends so mixed literals like 4 * v or v / 6.0 convert to T
+    friend constexpr basic_vec3 operator+(const basic_vec3& v1, const basic_vec3& v2) {
+        return basic_vec3{ v1.x + v2.x, v1.y + v2.y, v1.z + v2.z };
+    }
+
+    friend constexpr basic_vec3 operator-(const basic_vec3& v1, const basic_vec3& v2) {
+        return basic_vec3{ v1.x - v2.x, v1.y - v2.y, v1.z - v2.z };
+    }
+
+    friend constexpr basic_vec3 operator*(const basic_vec3& v, T val) {
+        return basic_vec3{ v.x * val, v.y * val, v.z * val };
+    }
+
+    friend constexpr basic_vec3 operator*(T val, const basic_vec3& v) {
+        return v * val;
+    }
+
+    friend constexpr basic_vec3 operator/(const basic_vec3& v, T val) {
+        return basic_vec3{ v.x / val, v.y / val, v.z / val };
+    }
+
+    friend constexpr basic_vec3 operator-(const basic_vec3& v1) {
+        return basic_vec3{ -v1.x, -v1.y, -v1.z };
+    }
+
+    friend constexpr bool operator==(const basic_vec3& v1, const basic_vec3& v2) {
+        return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z;
+    }
+
+    friend constexpr bool operator!=(const basic_vec3& v1, const basic_vec3& v2) {
+        return !(v1 == v2);
+    }
+
+    friend std::ostream& operator<< (std::ostream& out, const basic_vec3& v) {
+        out << "( " << v.x << " | " << v.y << " | " << v.z << " )";
+        return out;
+    }
+    };
+
+    using vec3 = basic_vec3<double>;
+    using vec3f = basic_vec3<float>;
+
+    /*
+     * Many vectors stored as structure of arrays, all x values next to each other, then all y
+     * and all z values. This is the layout the batched spline evaluation writes, so SIMD code can
+     * load and store a whole register of one component at once.
+     */
+    template<typename T>
+    struct basic_vec3_array {
+        std::vector<T> x{};
+        std::vector<T> y{};
+        std::vector<T> z{};
+
+    int size() const {
+        return x.size();
+    }
+
+    void resize(int size) {
+        x.resize(size);
+        y.resize(size);
+        z.resize(size);
+    }
+
+    void clear() {
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+
+    basic_vec3<T> get(int index) const {
+        return basic_vec3<T>{ x[index], y[index], z[index] };
+    }
+
+    void set(int index, const basic_vec3<T>& v) {
+        x[index] = v.x;
+        y[index] = v.y;
+        z[index] = v.z;
+    }
+    };
+
+    using vec3_array = basic_vec3_array<double>;
+    using vec3f_array = basic_vec3_array<float>;
+
+    template<typename T>
+    constexpr basic_vec3<T> lerp(const basic_vec3<T>& start, typename basic_vec3<T>::scalar t, const basic_vec3<T>& end) {
+        return start + (end - start) * t;
+    }
+
+    // converts a list of points to another precision, e.g. convertPoints<float>(points)
+    template<typename To, typename From>
+    std::vector<basic_vec3<To>> convertPoints(const std::vector<basic_vec3<From>>& points) {
+        std::vector<basic_vec3<To>> out{};
+        out.reserve(points.size());
+        for(const basic_vec3<From>& point: points) out.emplace_back(point);
+        return out;
+    }
+}
+
+#endif
@@ -73,6 +73,31 @@ namespace math {
         return (v2 - *this).length();
     }
 
+    vec& vec::operator+=(const vec& v2) {
+        matrix::operator+=(v2);
+        return *this;
+    }
+
+    vec& vec::operator-=(const vec& v2) {
+        matrix::operator-=(v2);
+        return *this;
+    }
+
+    vec& vec::operator*=(double value) {
+        matrix::operator*=(value);
+        return *this;
+    }
+
+    vec& vec::operator/=(double value) {
+        matrix::operator/=(value);
+        return *this;
+    }
+
+    vec& vec::addScaled(const vec& v2, double factor) {
+        matrix::addScaled(v2, factor);
+        return *this;
+    }
+
     //> Export
     std::vector<double> vec::toList() {
         std::vector<double> out{};
@@ -86,33 +111,83 @@ namespace math {
         return in;
     }
 
+    // Operators work on the elements directly, the rvalue overloads reuse the storage
+    // of a temporary operand so chains like p1 + 4 * p2 + p3 only allocate once
     vec operator+(const vec& v1, const vec& v2) {
-        matrix result = (matrix) v1 + (matrix) v2;
-        return result.getColumn(0);
+        vec out{ v1 };
+        out += v2;
+        return out;
+    }
+
+    vec operator+(vec&& v1, const vec& v2) {
+        v1 += v2;
+        return std::move(v1);
+    }
+
+    vec operator+(const vec& v1, vec&& v2) {
+        v2 += v1;
+        return std::move(v2);
+    }
+
+    vec operator+(vec&& v1, vec&& v2) {
+        v1 += v2;
+        return std::move(v1);
     }
 
     vec operator-(const vec& v1, const vec& v2) {
-        matrix result = (matrix) v1 - (matrix) v2;
-        return result.getColumn(0);
+        vec out{ v1 };
+        out -= v2;
+        return out;
+    }
+
+    vec operator-(vec&& v1, const vec& v2) {
+        v1 -= v2;
+        return std::move(v1);
+    }
+
+    vec operator-(const vec& v1, vec&& v2) {
+        v2 *= -1;
+        v2 += v1;
+        return std::move(v2);
+    }
+
+    vec operator-(vec&& v1, vec&& v2) {
+        v1 -= v2;
+        return std::move(v1);
     }
+
     vec operator*(const vec& v, float val) {
-        matrix result = (matrix) v * val;
-        return result.getColumn(0);
+        vec out{ v };
+        out *= val;
+        return out;
+    }
+
+    vec operator*(vec&& v, float val) {
+        v *= val;
+        return std::move(v);
     }
 
     vec operator*(float val, const vec& v) {
-        matrix result = (matrix) v * val;
-        return result.getColumn(0);
+        return v * val;
+    }
+
+    vec operator*(float val, vec&& v) {
+        return std::move(v) * val;
     }
 
     vec operator/(const vec& v, float val) {
-        matrix result = (matrix) v / val;
-        return result.getColumn(0);
+        vec out{ v };
+        out /= val;
+        return out;
+    }
+
+    vec operator/(vec&& v, float val) {
+        v /= val;
+        return std::move(v);
     }
 
     vec operator/(float val, const vec& v) {
-        matrix result = (matrix) v / val;
-        return result.getColumn(0);
+        return v / val;
     }
 
     std::ostream& operator<< (std::ostream& out, const vec& m) {
@@ -126,7 +201,13 @@ namespace math {
     }
 
     vec operator-(const vec& v1) {
-        matrix result = -(matrix) v1;
-        return result.getColumn(0);
+        vec out{ v1 };
+        out *= -1;
+        return out;
+    }
+
+    vec operator-(vec&& v1) {
+        v1 *= -1;
+        return std::move(v1);
     }
 }
@@ -14,9 +14,11 @@ namespace math {
     : matrix{ dimension, 1}
     { }
 
-    vec(const vec& m) 
-    : matrix{ m }
-    { }
+    vec(const vec& m) = default;
+    vec(vec&& m) noexcept = default;
+
+    vec& operator=(const vec& m) = default;
+    vec& operator=(vec&& m) noexcept = default;
 
     static vec vec2d(double x, double y) {
         return vec{x, y};
@@ -26,6 +28,13 @@ namespace math {
         return vec{x, y, z};
     }
 
+    // weights[0] * vectors[0] + weights[1] * vectors[1] + ..., one loop and one allocation
+    static vec linearCombination(std::initializer_list<double> weights, std::initializer_list<const matrix*> vectors) {
+        vec out{ vectors.size() == 0? 0: (*vectors.begin())->getAmountOfRows() };
+        out.setLinearCombination(weights, vectors);
+        return out;
+    }
+
     static vec fromList(const std::vector<double>& list) {
         vec out{ (int) list.size() };
         out.set(list);
@@ -51,6 +60,12 @@ namespace math {
 
     double distanceTo(const vec& v2) const;
 
+    vec& operator+=(const vec& v2);
+    vec& operator-=(const vec& v2);
+    vec& operator*=(double value);
+    vec& operator/=(double value);
+    vec& addScaled(const vec& v2, double factor);
+
     //> Export
     std::vector<double> toList();
     std::vector<double>& toList(std::vector<double>& in);
@@ -86,15 +101,25 @@ namespace math {
     };
 
     vec operator+(const vec& v1, const vec& v2);
+    vec operator+(vec&& v1, const vec& v2);
+    vec operator+(const vec& v1, vec&& v2);
+    vec operator+(vec&& v1, vec&& v2);
     vec operator-(const vec& v1, const vec& v2);
+    vec operator-(vec&& v1, const vec& v2);
+    vec operator-(const vec& v1, vec&& v2);
+    vec operator-(vec&& v1, vec&& v2);
     vec operator*(const vec& v, float val);
+    vec operator*(vec&& v, float val);
     vec operator*(float val, const vec& v);
+    vec operator*(float val, vec&& v);
 
     vec operator/(const vec& v, float val);
+    vec operator/(vec&& v, float val);
     vec operator/(float val, const vec& v);
     
     std::ostream& operator<< (std::ostream& out, const vec& m);
     vec operator-(const vec& v1);
+    vec operator-(vec&& v1);
 };
 
 #endif
\ No newline at end of file
@@ -4,15 +4,38 @@
 //https://www.raylib.com/cheatsheet/cheatsheet.html
 #include "raylib.h"
 
+// the buffers a mesh gets besides its positions
+struct vertex_attributes {
+    bool normals = false;           //3 floats per vertex
+    bool texcoords = false;         //2 floats per vertex
+    bool tangents = false;          //4 floats per vertex, w is the handedness of the bitangent
+};
+
 class meshbuilder {
 
     public:
-        meshbuilder(int triangles) 
+        // raylib's Mesh::indices are unsigned short, bigger meshes have to stay triangle soup
+        static constexpr int maxIndexedVertices = 65536;
+
+        // triangle soup, 3 vertices per triangle
+        meshbuilder(int triangles, vertex_attributes attributes = {}) 
         : mesh{ 0 }
         {
             mesh.triangleCount = triangles;
             mesh.vertexCount = mesh.triangleCount * 3;
             mesh.vertices = (float *)MemAlloc(mesh.vertexCount*3*sizeof(float));    // 3 vertices, 3 coordinates each (x, y, z)
+            allocateAttributes(attributes);
+        }
+
+        // indexed, vertexCount shared vertices (at most maxIndexedVertices) and 3 indices per triangle
+        meshbuilder(int vertexCount, int triangles, vertex_attributes attributes = {})
+        : mesh{ 0 }
+        {
+            mesh.triangleCount = triangles;
+            mesh.vertexCount = vertexCount;
+            mesh.vertices = (float *)MemAlloc(mesh.vertexCount*3*sizeof(float));
+            mesh.indices = (unsigned short *)MemAlloc(mesh.triangleCount*3*sizeof(unsigned short));
+            allocateAttributes(attributes);
         }
 
         meshbuilder& addVertex(Vector3 v) {
@@ -32,15 +55,117 @@ class meshbuilder {
             return *this;
         }
 
-        Mesh build() {
-            UploadMesh(&mesh, false);
+        // writes triangle index directly, for filling the mesh out of order (e.g. from several threads)
+        meshbuilder& setTriangle(int triangle, Vector3 v1, Vector3 v2, Vector3 v3) {
+            writeTriangle(mesh.vertices, triangle, v1, v2, v3);
+            return *this;
+        }
+
+        // indexed meshes only, the vertices are set with setVertex / getVertices
+        meshbuilder& setIndexedTriangle(int triangle, int i1, int i2, int i3) {
+            writeIndices(mesh.indices, triangle, i1, i2, i3);
+            return *this;
+        }
+
+        meshbuilder& setVertex(int index, Vector3 v) {
+            writeVertex(mesh.vertices, index, v);
+            return *this;
+        }
+
+        bool isIndexed() const {
+            return mesh.indices != nullptr;
+        }
+
+        // the vertex buffer, 3 coordinates per vertex (3 vertices per triangle for triangle soup)
+        float* getVertices() {
+            return mesh.vertices;
+        }
+
+        // the index buffer of an indexed mesh, 3 per triangle
+        unsigned short* getIndices() {
+            return mesh.indices;
+        }
+
+        // the attribute buffers, nullptr when not requested in the constructor
+        float* getNormals() {
+            return mesh.normals;
+        }
+
+        float* getTexcoords() {
+            return mesh.texcoords;
+        }
+
+        float* getTangents() {
+            return mesh.tangents;
+        }
+
+        // dynamic meshes can be patched later on with updateVertices
+        Mesh build(bool dynamic = false) {
+            UploadMesh(&mesh, dynamic);
             return mesh;
         }
 
+        static void writeVertex(float* vertices, int index, Vector3 v) {
+            float* out = vertices + index * 3;
+            out[0] = v.x;
+            out[1] = v.y;
+            out[2] = v.z;
+        }
+
+        static void writeTriangle(float* vertices, int triangle, Vector3 v1, Vector3 v2, Vector3 v3) {
+            writeVertex(vertices, triangle * 3, v1);
+            writeVertex(vertices, triangle * 3 + 1, v2);
+            writeVertex(vertices, triangle * 3 + 2, v3);
+        }
+
+        static void writeNormal(float* normals, int index, Vector3 n) {
+            writeVertex(normals, index, n);
+        }
+
+        static void writeTexcoord(float* texcoords, int index, Vector2 uv) {
+            texcoords[index * 2] = uv.x;
+            texcoords[index * 2 + 1] = uv.y;
+        }
+
+        static void writeTangent(float* tangents, int index, Vector4 t) {
+            float* out = tangents + index * 4;
+            out[0] = t.x;
+            out[1] = t.y;
+            out[2] = t.z;
+            out[3] = t.w;
+        }
+
+        // Index is unsigned short for raylib meshes, anything wider for meshes that never reach the gpu
+        template<typename Index>
+        static void writeIndices(Index* indices, int triangle, int i1, int i2, int i3) {
+            Index* out = indices + triangle * 3;
+            out[0] = (Index) i1;
+            out[1] = (Index) i2;
+            out[2] = (Index) i3;
+        }
+
+        //> Editing an uploaded (dynamic) mesh, the buffers are changed on the cpu first and then sent with updateVertices
+
+        // uploads vertices first to first + count - 1 of every buffer the mesh has (3 vertices per triangle for triangle soup),
+        // raylib keeps positions in buffer 0, texcoords in 1, normals in 2 and tangents in 4
+        static void updateVertices(const Mesh& mesh, int first, int count) {
+            if(count <= 0) return;
+            UpdateMeshBuffer(mesh, 0, mesh.vertices + first * 3, count * 3 * sizeof(float), first * 3 * sizeof(float));
+            if(mesh.texcoords) UpdateMeshBuffer(mesh, 1, mesh.texcoords + first * 2, count * 2 * sizeof(float), first * 2 * sizeof(float));
+            if(mesh.normals) UpdateMeshBuffer(mesh, 2, mesh.normals + first * 3, count * 3 * sizeof(float), first * 3 * sizeof(float));
+            if(mesh.tangents) UpdateMeshBuffer(mesh, 4, mesh.tangents + first * 4, count * 4 * sizeof(float), first * 4 * sizeof(float));
+        }
+
     private:
         Mesh mesh;
         int currentIndex = 0;
 
+        void allocateAttributes(vertex_attributes attributes) {
+            if(attributes.normals) mesh.normals = (float *)MemAlloc(mesh.vertexCount*3*sizeof(float));
+            if(attributes.texcoords) mesh.texcoords = (float *)MemAlloc(mesh.vertexCount*2*sizeof(float));
+            if(attributes.tangents) mesh.tangents = (float *)MemAlloc(mesh.vertexCount*4*sizeof(float));
+        }
+
 };
 
 #endif
\ No newline at end of file
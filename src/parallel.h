@@ -0,0 +1,113 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <vector>
+
+#ifndef PLATFORM_WEB
+#include <thread>
+#include <mutex>
+#include <deque>
+#endif
+
+namespace parallel {
+
+    // hardware threads, 1 on the web build (no pthreads there)
+    inline int threadCount() {
+#ifdef PLATFORM_WEB
+        return 1;
+#else
+        return std::max(1, (int) std::thread::hardware_concurrency());
+#endif
+    }
+
+    /*
+     * Splits [0, count) into one contiguous chunk per thread and calls function(first, last) for each,
+     * the calling thread takes the first chunk. Below minChunk items per thread fewer threads are used.
+     * Every index is handled by exactly one call, so writing to index i of a pre-sized buffer needs no locking
+     * and gives the same result as a serial loop.
+     */
+    template<typename Function>
+    void forChunks(int count, Function function, int minChunk = 1024, int threads = threadCount()) {
+        threads = std::max(1, std::min(threads, count / std::max(1, minChunk)));
+#ifdef PLATFORM_WEB
+        threads = 1;    //no threads to spawn, whatever the caller asked for
+#endif
+        if(threads == 1) {
+            if(count > 0) function(0, count);
+            return;
+        }
+
+#ifndef PLATFORM_WEB
+        std::vector<std::thread> workers{};
+        workers.reserve(threads - 1);
+        for(int i = 1; i < threads; i++) {
+            int first = (int) ((long long) count * i / threads);
+            int last = (int) ((long long) count * (i + 1) / threads);
+            workers.emplace_back(function, first, last);
+        }
+
+        function(0, (int) ((long long) count / threads));
+        for(std::thread& worker: workers) worker.join();
+#endif
+    }
+
+    /*
+     * Calls function(i) for every i in [0, count) on a work stealing pool, for items of very different cost.
+     * Every thread starts with a contiguous block of indices and works from its back. A thread that
+     * runs out steals from the front of the other queues, so the big items do not leave threads idle.
+     */
+    template<typename Function>
+    void forEachStealing(int count, Function function, int threads = threadCount()) {
+        threads = std::max(1, std::min(threads, count));
+#ifdef PLATFORM_WEB
+        threads = 1;
+#endif
+        if(threads == 1) {
+            for(int i = 0; i < count; i++) function(i);
+            return;
+        }
+
+#ifndef PLATFORM_WEB
+        struct queue {
+            std::mutex lock{};
+            std::deque<int> items{};
+        };
+        std::vector<queue> queues(threads);
+        for(int i = 0; i < count; i++) queues[(long long) i * threads / count].items.push_back(i);
+
+        auto take = [&](int thread, int& item) {
+            for(int offset = 0; offset < threads; offset++) {
+                queue& q{ queues[(thread + offset) % threads] };
+                std::lock_guard<std::mutex> guard{ q.lock };
+                if(q.items.empty()) continue;
+
+                // own queue from the back, others from the front
+                if(offset == 0) {
+                    item = q.items.back();
+                    q.items.pop_back();
+                } else {
+                    item = q.items.front();
+                    q.items.pop_front();
+                }
+                return true;
+            }
+            return false;
+        };
+
+        auto work = [&](int thread) {
+            int item;
+            while(take(thread, item)) function(item);
+        };
+
+        std::vector<std::thread> workers{};
+        workers.reserve(threads - 1);
+        for(int i = 1; i < threads; i++) workers.emplace_back(work, i);
+
+        work(0);
+        for(std::thread& worker: workers) worker.join();
+#endif
+    }
+}
+
+#endif
@@ -1,24 +1,112 @@
 #ifndef POINT_H
 #define POINT_H
 
-#include "math/matrix.h"
-#include "math/vector.h"
+#include <vector>
 
-struct oriented_point {
-    math::vec position;
-    math::matrix rotation;
+#include "math/vec3.h"
+#include "math/mat3.h"
+#include "math/quat.h"
 
-    math::vec localToWorld(math::vec point) {
+/*
+ * A position plus an orientation, rotation maps local to world directions.
+ * The rotation built by lookRotation is orthonormal, so by default the point is treated as
+ * a rigid transform and its inverse is just the transposed rotation.
+ * Set rigid to false when rotation contains scale or shear.
+ */
+template<typename T>
+struct basic_oriented_point {
+    using vector = math::basic_vec3<T>;
+    using matrix = math::basic_mat3<T>;
+
+    vector position;
+    matrix rotation;
+    bool rigid = true;
+
+    vector localToWorld(const vector& point) const {
         return position + rotation * point;
     }
 
-    math::vec worldToLocal(math::vec point) {
+    vector worldToLocal(const vector& point) const {
+        if(rigid) return rotation.transposeMultiply(point - position);
         return rotation.inverse() * (point - position);
     }
 
-    math::vec worldToLocalDirection(math::vec point) {
-        return rotation * point;
+    vector localToWorldDirection(const vector& direction) const {
+        return rotation * direction;
+    }
+
+    vector worldToLocalDirection(const vector& direction) const {
+        if(rigid) return rotation.transposeMultiply(direction);
+        return rotation.inverse() * direction;
+    }
+
+    //> Batch versions, append to out and return it
+    std::vector<vector>& localToWorld(const std::vector<vector>& points, std::vector<vector>& out) const {
+        out.reserve(out.size() + points.size());
+        for(const vector& point: points) out.push_back(position + rotation * point);
+        return out;
+    }
+
+    std::vector<vector>& worldToLocal(const std::vector<vector>& points, std::vector<vector>& out) const {
+        matrix inverseRotation{ inverse().rotation };
+
+        out.reserve(out.size() + points.size());
+        for(const vector& point: points) out.push_back(inverseRotation * (point - position));
+        return out;
+    }
+
+    // the transform mapping world to local coordinates, keep it around to map many points back
+    basic_oriented_point inverse() const {
+        matrix inverseRotation{ rigid? rotation.transpose(): rotation.inverse() };
+        return basic_oriented_point{ -(inverseRotation * position), inverseRotation, rigid };
+    }
+};
+
+/*
+ * Same as oriented_point but with the rotation stored as a quaternion.
+ * Cheap to store per track sample and to blend between samples.
+ */
+template<typename T>
+struct basic_oriented_pose {
+    using vector = math::basic_vec3<T>;
+
+    vector position;
+    math::basic_quat<T> rotation;
+
+    static basic_oriented_pose fromOrientedPoint(const basic_oriented_point<T>& point) {
+        return basic_oriented_pose{ point.position, math::basic_quat<T>::fromMatrix(point.rotation) };
+    }
+
+    basic_oriented_point<T> toOrientedPoint() const {
+        return basic_oriented_point<T>{ position, rotation.toMatrix() };
+    }
+
+    vector localToWorld(const vector& point) const {
+        return position + rotation.rotate(point);
+    }
+
+    vector worldToLocal(const vector& point) const {
+        return rotation.inverseRotate(point - position);
+    }
+
+    vector localToWorldDirection(const vector& direction) const {
+        return rotation.rotate(direction);
+    }
+
+    vector worldToLocalDirection(const vector& direction) const {
+        return rotation.inverseRotate(direction);
     }
 };
 
-#endif
\ No newline at end of file
+using oriented_point = basic_oriented_point<double>;
+using oriented_pointf = basic_oriented_point<float>;
+using oriented_pose = basic_oriented_pose<double>;
+using oriented_posef = basic_oriented_pose<float>;
+
+// lerps the position and slerps the rotation
+template<typename T>
+basic_oriented_pose<T> blend(const basic_oriented_pose<T>& start, typename math::basic_vec3<T>::scalar t, const basic_oriented_pose<T>& end) {
+    return basic_oriented_pose<T>{ math::lerp(start.position, t, end.position), math::slerp(start.rotation, t, end.rotation) };
+}
+
+#endif
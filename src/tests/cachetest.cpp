@@ -0,0 +1,59 @@
+/*
+ * Checks that a track loaded from the cache draws the same triangles as the freshly built one.
+ *
+ * There is no window here, headlessgpu.h stands in for raylib and reads the meshes back the way
+ * DrawMesh draws them.
+ * Returns 1 when a check fails.
+ *
+ * build/Makefile: make test
+ */
+#include <cstdio>
+#include <vector>
+
+#include "../extrude.h"
+#include "../trackchunks.h"
+#include "../trackcache.h"
+#include "headlessgpu.h"
+#include "testcheck.h"
+#include "../math/vec3.h"
+#include "../math/splines/catmullromspline.h"
+#include "../math/splines/frametable.h"
+#include "../math/splines/tessellation.h"
+
+int main() {
+    std::vector<math::vec3f> trackPoints{ { 2, 4, 0 }, { 7, 0, 20 }, { 12, -4, 5 }, { -12, 0, 17 }, { -20, 2, 5 } };
+    math::catmullrom_splinef spline{ trackPoints };
+    math::frame_tablef frames{ spline, 50 };
+
+    std::vector<oriented_posef> edgeLoops{};
+    math::tessellateAdaptive(frames, math::tessellation_tolerance{}, edgeLoops);
+
+    const std::vector<Vector3> outline{ GetOutline() };
+    std::vector<track_chunk> built{ extrudeChunks(outline, edgeLoops, 10.0f, 3) };
+
+    const std::string path{ "cachetest.cache" };
+    std::uint64_t key{ cache_key{}.add(trackPoints).add(outline).get() };
+    check(saveTrackCache(path, key, built), "saveTrackCache");
+
+    std::vector<track_chunk> loaded{};
+    check(!loadTrackCache(path, key + 1, loaded) && loaded.empty(), "a different key is a miss");
+    check(loadTrackCache(path, key, loaded), "loadTrackCache");
+    check(loaded.size() == built.size(), "chunk count");
+
+    for(std::size_t c = 0; c < std::min(loaded.size(), built.size()); c++) {
+        check(loaded[c].levels.size() == built[c].levels.size(), "level count");
+        check(loaded[c].firstEdgeLoop == built[c].firstEdgeLoop && loaded[c].lastEdgeLoop == built[c].lastEdgeLoop, "edgeloop range");
+        check(loaded[c].radius == built[c].radius, "bounding sphere");
+
+        for(std::size_t level = 0; level < std::min(loaded[c].levels.size(), built[c].levels.size()); level++) {
+            const Mesh& hit{ loaded[c].levels[level].meshes[0] };
+            const Mesh& miss{ built[c].levels[level].meshes[0] };
+            check(hit.indices != nullptr, "a cached mesh keeps its indices");
+            check(hit.vertices == nullptr, "a cached mesh does not point into the mapped file");
+            check(drawnCorners(hit) == drawnCorners(miss), "a cached mesh draws the same triangles");
+        }
+    }
+
+    std::remove(path.c_str());
+    return testResult("cachetest");
+}
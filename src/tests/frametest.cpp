@@ -0,0 +1,55 @@
+/*
+ * Checks that the frames of the splines and the frame table map local to world coordinates:
+ * local +z has to be the direction of the track (the normalized getDerivate(u)) and
+ * worldToLocal has to undo localToWorld. Returns 1 when a check fails.
+ *
+ * build/Makefile: make test
+ */
+#include <vector>
+
+#include "../point.h"
+#include "../math/vec3.h"
+#include "../math/splines/catmullromspline.h"
+#include "../math/splines/bspline.h"
+#include "../math/splines/frametable.h"
+#include "testcheck.h"
+
+template<typename T>
+static void checkPoint(const math::basic_spline<T>& spline, const basic_oriented_point<T>& p, double u, double tolerance) {
+    using vector = math::basic_vec3<T>;
+    vector tangent{ spline.getDerivate(u).normalize() };
+    vector forward{ p.localToWorld(vector{ 0, 0, 1 }) - p.position };
+
+    check(forward.dot(tangent) > 1 - tolerance, "local +z is the tangent", "u", u);
+    check(p.localToWorldDirection(vector{ 0, 0, 1 }).dot(tangent) > 1 - tolerance, "localToWorldDirection(+z) is the tangent", "u", u);
+
+    vector local{ 0.5, -0.25, 2 };
+    check((p.worldToLocal(p.localToWorld(local)) - local).length() < tolerance * 10, "worldToLocal undoes localToWorld", "u", u);
+    check((p.worldToLocalDirection(p.localToWorldDirection(local)) - local).length() < tolerance * 10, "worldToLocalDirection undoes localToWorldDirection", "u", u);
+}
+
+template<typename T>
+static void checkSpline(const math::basic_spline<T>& spline, double tolerance) {
+    for(double u = 0; u <= spline.getSegmentCount(); u += 0.05) checkPoint(spline, spline.getOrientedPoint(u), u, tolerance);
+
+    math::basic_frame_table<T> frames{ spline, 50 };
+    for(int i = 0; i < frames.getSampleCount(); i++) {
+        double u = frames.getSampleU(i);
+        const basic_oriented_pose<T>& pose{ frames.getSample(i) };
+        checkPoint(spline, pose.toOrientedPoint(), u, tolerance);
+
+        math::basic_vec3<T> forward{ pose.localToWorld(math::basic_vec3<T>{ 0, 0, 1 }) - pose.position };
+        check(forward.dot(spline.getDerivate(u).normalize()) > 1 - tolerance, "pose local +z is the tangent", "u", u);
+    }
+}
+
+int main() {
+    std::vector<math::vec3> track{ { 2, 4, 0 }, { 7, 0, 20 }, { 12, -4, 5 }, { -12, 0, 17 }, { -20, 2, 5 } };
+
+    checkSpline(math::catmullrom_spline{ track }, 1e-9);
+    checkSpline(math::b_spline{ track }, 1e-9);
+    checkSpline(math::catmullrom_splinef{ math::convertPoints<float>(track) }, 1e-4);
+    checkSpline(math::b_splinef{ math::convertPoints<float>(track) }, 1e-4);
+
+    return testResult("frametest");
+}
@@ -0,0 +1,84 @@
+#ifndef HEADLESSGPU_H
+#define HEADLESSGPU_H
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "raylib.h"
+
+/*
+ * Stand-ins for the raylib functions the track code calls, so the tests run without a window or gpu.
+ * UploadMesh and UpdateMeshBuffer write to a fake gpu, drawnCorners() reads a mesh back from it the
+ * way DrawMesh does: indexed when Mesh::indices is set, 3 consecutive vertices per triangle otherwise.
+ * The tests link against these instead of raylib, include this header from one file per test only.
+ */
+
+// what was uploaded for a mesh, Mesh::vaoId - 1 indexes gpuMeshes
+struct gpu_mesh {
+    std::vector<float> buffers[5]{};    //by raylib's buffer index: positions, texcoords, normals, colors (unused), tangents
+    std::vector<unsigned short> indices{};
+};
+
+static std::vector<gpu_mesh> gpuMeshes{};
+
+void* MemAlloc(unsigned int size) {
+    return std::calloc(size, 1);
+}
+
+void MemFree(void* ptr) {
+    std::free(ptr);
+}
+
+void UploadMesh(Mesh* mesh, bool) {
+    gpu_mesh uploaded{};
+    auto copy = [](const auto* data, int count, auto& out) {
+        if(data) out.assign(data, data + count);
+    };
+    copy(mesh->vertices, mesh->vertexCount * 3, uploaded.buffers[0]);
+    copy(mesh->texcoords, mesh->vertexCount * 2, uploaded.buffers[1]);
+    copy(mesh->normals, mesh->vertexCount * 3, uploaded.buffers[2]);
+    copy(mesh->tangents, mesh->vertexCount * 4, uploaded.buffers[4]);
+    copy(mesh->indices, mesh->triangleCount * 3, uploaded.indices);
+
+    gpuMeshes.push_back(uploaded);
+    mesh->vaoId = gpuMeshes.size();
+}
+
+void UpdateMeshBuffer(Mesh mesh, int index, const void* data, int dataSize, int offset) {
+    std::vector<float>& buffer{ gpuMeshes.at(mesh.vaoId - 1).buffers[index] };
+    if(offset < 0 || offset + dataSize > (int) (buffer.size() * sizeof(float))) std::abort();
+    std::memcpy((char*) buffer.data() + offset, data, dataSize);
+}
+
+Model LoadModelFromMesh(Mesh mesh) {
+    Model model{};
+    model.meshCount = 1;
+    model.meshes = (Mesh*) MemAlloc(sizeof(Mesh));
+    model.meshes[0] = mesh;
+    return model;
+}
+
+// the uploaded attributes of every corner of every triangle the mesh draws, size floats per corner
+inline std::vector<float> drawnCorners(const Mesh& mesh, int buffer, int size) {
+    const gpu_mesh& uploaded{ gpuMeshes.at(mesh.vaoId - 1) };
+    const std::vector<float>& source{ uploaded.buffers[buffer] };
+
+    std::vector<float> corners{};
+    if(source.empty()) return corners;
+    for(int corner = 0; corner < mesh.triangleCount * 3; corner++) {
+        int i = mesh.indices? uploaded.indices.at(corner): corner;
+        corners.insert(corners.end(), source.begin() + i * size, source.begin() + (i + 1) * size);
+    }
+    return corners;
+}
+
+// positions, normals and texcoords of every drawn corner
+inline std::vector<float> drawnCorners(const Mesh& mesh) {
+    std::vector<float> corners{ drawnCorners(mesh, 0, 3) };
+    for(float f: drawnCorners(mesh, 2, 3)) corners.push_back(f);
+    for(float f: drawnCorners(mesh, 1, 2)) corners.push_back(f);
+    return corners;
+}
+
+#endif
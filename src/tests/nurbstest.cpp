@@ -0,0 +1,64 @@
+/*
+ * Checks that a nurbs stays consistent after its control points are edited: the span polynomials
+ * (stepper, frame tables and bvh read those) have to match get(), and setControlPoint has to
+ * return exactly the segments whose shape changed.
+ *
+ * build/Makefile: make test
+ */
+#include <vector>
+
+#include "../math/vec3.h"
+#include "../math/splines/nurbs.h"
+#include "testcheck.h"
+
+// largest distance between get() and the polynomial of the segment, over every segment
+template<typename T>
+static double polynomialError(const math::basic_nurbs<T>& curve) {
+    double error = 0;
+    for(int segment = 0; segment < curve.getSegmentCount(); segment++) {
+        math::cubic_polynomial<T> polynomial;
+        if(!curve.getSegmentPolynomial(segment, polynomial)) return -1;
+
+        for(int i = 0; i <= 10; i++) {
+            T t = (T) i / 10;
+            error = std::max(error, (double) (math::vec3{ polynomial.get(t) } - math::vec3{ curve.get(segment + t) }).length());
+        }
+    }
+    return error;
+}
+
+static void checkEdits(const std::vector<math::vec3>& points, int degree, std::vector<double> knots) {
+    math::nurbs curve{ points, degree, knots };
+    check(polynomialError(curve) >= 0 && polynomialError(curve) < 1e-9, "the polynomials match get before an edit");
+
+    for(int index = 0; index < (int) points.size(); index++) {
+        std::vector<math::vec3> before{};
+        for(int segment = 0; segment < curve.getSegmentCount(); segment++) before.push_back(curve.get(segment + 0.5));
+
+        std::vector<math::segment_range> changed{ curve.setControlPoint(index, points[index] + math::vec3{ 1, -2, 0.5 }) };
+        check(polynomialError(curve) < 1e-9, "the polynomials match get after setControlPoint", "index", index);
+
+        for(int segment = 0; segment < curve.getSegmentCount(); segment++) {
+            bool inside = false;
+            for(const math::segment_range& range: changed) inside |= segment >= range.first && segment < range.last;
+
+            bool moved = (curve.get(segment + 0.5) - before[segment]).length() > 1e-12;
+            check(moved == inside, "setControlPoint returns the segments that changed", "index", index);
+        }
+    }
+
+    std::vector<math::vec3> shifted{};
+    for(const math::vec3& p: points) shifted.push_back(p + math::vec3{ 0, 3, 0 });
+    curve.setControlPoints(shifted);
+    check(polynomialError(curve) < 1e-9, "the polynomials match get after setControlPoints");
+}
+
+int main() {
+    std::vector<math::vec3> points{ { 0, 0, 0 }, { 1, 2, 0 }, { 3, 3, 1 }, { 5, 1, 2 }, { 7, 0, 0 }, { 9, 2, 1 }, { 11, 0, 3 }, { 12, 4, 1 } };
+
+    checkEdits(points, 3, {});
+    checkEdits(points, 2, {});
+    checkEdits(points, 3, { 0, 0, 0, 0, 1, 1, 2.5, 4, 5, 5, 5, 5 });      //non-uniform, with an empty span
+
+    return testResult("nurbstest");
+}
@@ -0,0 +1,31 @@
+#ifndef TESTCHECK_H
+#define TESTCHECK_H
+
+#include <iostream>
+
+/*
+ * What every test shares: check() prints and counts the failed conditions, testResult() reports
+ * the outcome and is the exit code of main, 1 when a check failed.
+ */
+inline int testFailures = 0;
+
+inline void check(bool condition, const char* what) {
+    if(condition) return;
+    std::cout << "failed: " << what << std::endl;
+    testFailures++;
+}
+
+// with the value the check was made at, e.g. check(..., "u", u)
+template<typename Value>
+void check(bool condition, const char* what, const char* name, const Value& value) {
+    if(condition) return;
+    std::cout << "failed: " << what << " at " << name << " = " << value << std::endl;
+    testFailures++;
+}
+
+inline int testResult(const char* test) {
+    std::cout << test << (testFailures? " failed": " passed") << std::endl;
+    return testFailures? 1: 0;
+}
+
+#endif
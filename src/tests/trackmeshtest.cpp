@@ -0,0 +1,79 @@
+/*
+ * Checks that track_mesh::update after an edit leaves the same triangles on the gpu as a track_mesh
+ * built from scratch on the edited frames, for an indexed and a triangle soup track.
+ * Texcoord u may differ inside the edit (it is stretched there), so for u the check is that the
+ * triangles outside the edit keep theirs and no triangle spans a jump.
+ * Returns 1 when a check fails.
+ *
+ * build/Makefile: make test
+ */
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../extrude.h"
+#include "../trackmesh.h"
+#include "headlessgpu.h"
+#include "testcheck.h"
+#include "../math/vec3.h"
+#include "../math/splines/catmullromspline.h"
+#include "../math/splines/frametable.h"
+
+static void checkEdit(std::vector<math::vec3f> points, int index, const math::vec3f& offset, bool indexed) {
+    const std::vector<Vector3> outline{ GetOutline() };
+    const vertex_attributes attributes{ true, true, true };
+    const int samplesPerSegment = 50;
+
+    math::catmullrom_splinef spline{ points };
+    math::frame_tablef frames{ spline, samplesPerSegment };
+    track_mesh<float> track{ outline, frames, attributes };
+    check(track.isIndexed() == indexed, indexed? "the short track is indexed": "the long track is triangle soup");
+    std::vector<float> texcoordsBefore{ drawnCorners(track.getMesh(), 1, 2) };
+
+    std::vector<math::segment_range> changed{ spline.setControlPoint(index, points[index] + offset) };
+    frames.update(changed);
+    track.update(changed);
+
+    track_mesh<float> rebuilt{ outline, frames, attributes };
+    check(drawnCorners(track.getMesh(), 0, 3) == drawnCorners(rebuilt.getMesh(), 0, 3), "positions match a rebuild");
+    check(drawnCorners(track.getMesh(), 2, 3) == drawnCorners(rebuilt.getMesh(), 2, 3), "normals match a rebuild");
+    check(drawnCorners(track.getMesh(), 4, 4) == drawnCorners(rebuilt.getMesh(), 4, 4), "tangents match a rebuild");
+
+    // corners are in loop pair order, (outline - 1) * 2 triangles per pair
+    std::vector<float> texcoords{ drawnCorners(track.getMesh(), 1, 2) };
+    int cornersPerPair = (outline.size() - 1) * 2 * 3;
+    int changedCorners = 0;
+    for(int corner = 0; corner < (int) texcoords.size() / 2; corner++) {
+        int pair = corner / cornersPerPair;
+        bool inside = false;
+        for(const math::segment_range& range: changed) inside |= pair >= range.first * samplesPerSegment - 1 && pair < range.last * samplesPerSegment;
+
+        if(texcoords[corner * 2] != texcoordsBefore[corner * 2]) changedCorners++;
+        if(!inside) check(texcoords[corner * 2] == texcoordsBefore[corner * 2], "texcoords outside the edit stay");
+        check(texcoords[corner * 2 + 1] == texcoordsBefore[corner * 2 + 1], "texcoord v stays");
+    }
+    check(changedCorners > 0, "the edit changes texcoord u");
+
+    // a triangle spans two neighbouring loops, the stretch inside the edit keeps u close to the rebuild there
+    std::vector<float> rebuiltTexcoords{ drawnCorners(rebuilt.getMesh(), 1, 2) };
+    auto span = [](const std::vector<float>& t, int triangle) {
+        float u[3]{ t[triangle * 6], t[triangle * 6 + 2], t[triangle * 6 + 4] };
+        return std::max({ u[0], u[1], u[2] }) - std::min({ u[0], u[1], u[2] });
+    };
+    for(int triangle = 0; triangle < (int) texcoords.size() / 6; triangle++) {
+        check(span(texcoords, triangle) <= span(rebuiltTexcoords, triangle) * 2 + 1e-3f, "no jump in texcoord u");
+    }
+}
+
+int main() {
+    checkEdit({ { 2, 4, 0 }, { 7, 0, 20 }, { 12, -4, 5 }, { -12, 0, 17 }, { -20, 2, 5 } }, 2, math::vec3f{ 0, 3, -2 }, true);
+
+    // more vertices than raylib can index
+    std::mt19937 random{ 11 };
+    std::uniform_real_distribution<float> coordinate{ -200, 200 };
+    std::vector<math::vec3f> longTrack{};
+    for(int i = 0; i < 300; i++) longTrack.push_back(math::vec3f{ coordinate(random), coordinate(random) / 10, coordinate(random) });
+    checkEdit(longTrack, 150, math::vec3f{ 5, 5, 5 }, false);
+
+    return testResult("trackmeshtest");
+}
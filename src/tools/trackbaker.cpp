@@ -0,0 +1,208 @@
+/*
+ * Bakes a directory of track definitions to meshes, without a window or gpu.
+ *
+ *  TrackBaker <track directory> <output directory> [threads] [mesh | obj | glb]
+ *
+ * A track definition is a text file with one control point "x y z" per line, '#' starts a comment.
+ * An optional line "spline catmullrom | bspline | nurbs" picks the spline type, catmull-rom by default.
+ * Every track is tessellated like the game does it (frame table, adaptive edgeloops, extrusion of
+ * GetOutline()) and written to <output directory>/<name>.mesh:
+ *
+ *  char[4]   "TRKM"
+ *  uint32    vertex count
+ *  uint32    triangle count
+ *  float[]   x, y, z per vertex, like Mesh::vertices
+ *  uint32[]  3 vertex indices per triangle
+ *
+ * obj and glb write <name>.obj / <name>.glb with trackexport.h instead, streamed edgeloop by edgeloop.
+ *
+ * The tracks are distributed with parallel::forEachStealing, a long track does not hold up the
+ * threads that got the short ones. Every track is extruded on a single thread.
+ *
+ * build/Makefile: make tools
+ */
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../extrude.h"
+#include "../trackexport.h"
+#include "../parallel.h"
+#include "../math/vec3.h"
+#include "../math/splines/spline.h"
+#include "../math/splines/catmullromspline.h"
+#include "../math/splines/bspline.h"
+#include "../math/splines/nurbs.h"
+#include "../math/splines/frametable.h"
+#include "../math/splines/tessellation.h"
+
+namespace fs = std::filesystem;
+
+struct track_result {
+    std::string name{};
+    bool ok = false;
+    int edgeLoops = 0;
+    int triangles = 0;
+    double milliseconds = 0;
+};
+
+static bool readTrack(const fs::path& file, std::string& type, std::vector<math::vec3f>& points) {
+    std::ifstream in{ file };
+    if(!in) return false;
+
+    std::string line;
+    while(std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream words{ line };
+        std::string first;
+        if(!(words >> first)) continue;
+
+        if(first == "spline") {
+            words >> type;
+            continue;
+        }
+
+        std::istringstream coordinates{ line };
+        math::vec3f p{};
+        if(!(coordinates >> p.x >> p.y >> p.z)) {
+            std::cerr << file.string() << ": can not read control point \"" << line << "\"" << std::endl;
+            return false;
+        }
+        points.push_back(p);
+    }
+    return true;
+}
+
+static std::unique_ptr<math::basic_spline<float>> makeSpline(const std::string& type, std::vector<math::vec3f> points) {
+    if(type == "catmullrom") return std::make_unique<math::catmullrom_splinef>(std::move(points));
+    if(type == "bspline") return std::make_unique<math::b_splinef>(std::move(points));
+    if(type == "nurbs") return std::make_unique<math::nurbsf>(std::move(points));
+    return nullptr;
+}
+
+static bool writeMesh(const fs::path& file, const std::vector<float>& vertices, const std::vector<std::uint32_t>& indices) {
+    std::ofstream out{ file, std::ios::binary };
+    if(!out) return false;
+
+    std::uint32_t vertexCount = vertices.size() / 3;
+    std::uint32_t triangles = indices.size() / 3;
+    out.write("TRKM", 4);
+    out.write((const char*) &vertexCount, sizeof(vertexCount));
+    out.write((const char*) &triangles, sizeof(triangles));
+    out.write((const char*) vertices.data(), vertices.size() * sizeof(float));
+    out.write((const char*) indices.data(), indices.size() * sizeof(std::uint32_t));
+    return (bool) out;
+}
+
+static track_result bake(const fs::path& file, const fs::path& outputDirectory, const std::string& format, const std::vector<Vector3>& outline) {
+    auto start = std::chrono::steady_clock::now();
+    track_result result{ file.stem().string() };
+
+    std::string type{ "catmullrom" };
+    std::vector<math::vec3f> points{};
+    if(!readTrack(file, type, points)) return result;
+    if(points.size() < 4) {
+        std::cerr << file.string() << ": needs at least 4 control points" << std::endl;
+        return result;
+    }
+
+    std::unique_ptr<math::basic_spline<float>> spline{ makeSpline(type, std::move(points)) };
+    if(!spline) {
+        std::cerr << file.string() << ": unknown spline type " << type << std::endl;
+        return result;
+    }
+
+    math::frame_tablef frames{ *spline, 50 };
+    std::vector<oriented_posef> edgeLoops{};
+    math::tessellation_report report{ math::tessellateAdaptive(frames, math::tessellation_tolerance{}, edgeLoops) };
+
+    result.triangles = extrudedTriangleCount(outline.size(), edgeLoops.size());
+    fs::path outputFile{ outputDirectory / (result.name + "." + format) };
+    if(format == "obj") {
+        result.ok = exportObj(outputFile.string(), outline, edgeLoops);
+    } else if(format == "glb") {
+        result.ok = exportGlb(outputFile.string(), outline, edgeLoops);
+    } else {
+        // one thread per track, the tracks themselves already keep every core busy
+        std::vector<float> vertices(extrudedVertexCount(outline.size(), edgeLoops.size()) * 3);
+        std::vector<std::uint32_t> indices(result.triangles * 3);
+        extrudeVertices(outline, edgeLoops, extrusion_buffers{ vertices.data() }, 1);
+        extrudeIndices(outline.size(), edgeLoops.size(), indices.data(), 1);
+
+        result.ok = writeMesh(outputFile, vertices, indices);
+    }
+    if(!result.ok) std::cerr << result.name << ": can not write the mesh" << std::endl;
+
+    result.edgeLoops = report.edgeLoops;
+    result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+int main(int argc, char** argv) {
+    if(argc < 3) {
+        std::cerr << "usage: TrackBaker <track directory> <output directory> [threads] [mesh | obj | glb]" << std::endl;
+        return 1;
+    }
+
+    fs::path inputDirectory{ argv[1] };
+    fs::path outputDirectory{ argv[2] };
+    int threads = argc > 3? std::max(1, std::atoi(argv[3])): parallel::threadCount();
+    std::string format{ argc > 4? argv[4]: "mesh" };
+    if(format != "mesh" && format != "obj" && format != "glb") {
+        std::cerr << "unknown format " << format << ", use mesh, obj or glb" << std::endl;
+        return 1;
+    }
+
+    std::error_code error;
+    if(!fs::is_directory(inputDirectory, error)) {
+        std::cerr << inputDirectory.string() << " is not a directory" << std::endl;
+        return 1;
+    }
+    fs::create_directories(outputDirectory, error);
+    if(error) {
+        std::cerr << "can not create " << outputDirectory.string() << ": " << error.message() << std::endl;
+        return 1;
+    }
+
+    std::vector<fs::path> files{};
+    for(const fs::directory_entry& entry: fs::directory_iterator{ inputDirectory }) {
+        if(entry.is_regular_file()) files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    const std::vector<Vector3> outline{ GetOutline() };
+    std::vector<track_result> results(files.size());
+
+    auto start = std::chrono::steady_clock::now();
+    parallel::forEachStealing(files.size(), [&](int i) {
+        results[i] = bake(files[i], outputDirectory, format, outline);
+    }, threads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int baked = 0;
+    long long triangles = 0;
+    for(const track_result& r: results) {
+        if(!r.ok) {
+            std::cout << r.name << ": failed" << std::endl;
+            continue;
+        }
+
+        baked++;
+        triangles += r.triangles;
+        std::cout << r.name << ": " << r.edgeLoops << " edgeloops, " << r.triangles << " triangles, "
+                  << r.milliseconds << " ms (" << r.triangles / std::max(r.milliseconds, 1e-6) * 1000 << " triangles/s)" << std::endl;
+    }
+
+    std::cout << baked << "/" << results.size() << " tracks, " << triangles << " triangles in " << seconds * 1000 << " ms on "
+              << threads << " threads: " << baked / std::max(seconds, 1e-9) << " tracks/s, "
+              << triangles / std::max(seconds, 1e-9) << " triangles/s" << std::endl;
+
+    return baked == (int) results.size()? 0: 1;
+}
@@ -0,0 +1,274 @@
+#ifndef TRACKCACHE_H
+#define TRACKCACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "raylib.h"
+#include "trackchunks.h"
+#include "mappedfile.h"
+
+/*
+ * On-disk cache of the chunked track meshes, so a known track starts without evaluating a spline.
+ *
+ * The file is flat and little-endian, every array starts 4 byte aligned:
+ *
+ *  cache_header                  magic, version, key and counts
+ *  cache_chunk[chunkCount]       bounds and levels of every chunk
+ *  cache_mesh[meshCount]         counts and file offsets of the buffers of every mesh, 0 = not there
+ *  buffers                       Mesh::vertices, normals, texcoords, tangents (float), indices (unsigned short)
+ *
+ * loadTrackCache maps the file and hands the vertex buffers to UploadMesh where they lie, nothing is
+ * parsed. Only the indices are copied: raylib draws a mesh indexed only while Mesh::indices is set, so
+ * every cached mesh owns a copy of them (freed by UnloadModel). Their vertex pointers are cleared once
+ * the data is on the gpu, so drawing and unloading work on them, saveTrackCache or computeChunkBounds do not.
+ *
+ * The key is a hash of everything the meshes are made from (see cache_key). A file with another
+ * key or format version, a big-endian machine or a truncated file is a miss, then the track is
+ * built as usual and saveTrackCache replaces the file.
+ */
+namespace trackcache {
+    constexpr std::uint32_t formatVersion = 2;    //bumped whenever the cached meshes would come out differently
+
+    struct cache_header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t key;
+        std::uint32_t chunkCount;
+        std::uint32_t meshCount;
+        std::uint64_t fileSize;
+    };
+
+    struct cache_chunk {
+        float boundsMin[3];
+        float boundsMax[3];
+        float center[3];
+        float radius;
+        std::int32_t firstEdgeLoop;
+        std::int32_t lastEdgeLoop;
+        std::uint32_t firstMesh;
+        std::uint32_t levelCount;
+    };
+
+    struct cache_mesh {
+        std::uint32_t vertexCount;
+        std::uint32_t triangleCount;
+        std::uint64_t vertices;
+        std::uint64_t normals;
+        std::uint64_t texcoords;
+        std::uint64_t tangents;
+        std::uint64_t indices;
+    };
+
+    static_assert(sizeof(cache_header) == 32 && sizeof(cache_chunk) == 56 && sizeof(cache_mesh) == 48, "the cache layout must not depend on the compiler");
+
+    inline bool littleEndian() {
+        std::uint16_t one = 1;
+        unsigned char first;
+        std::memcpy(&first, &one, 1);
+        return first == 1;
+    }
+
+    inline std::uint64_t aligned(std::uint64_t offset) {
+        return (offset + 3) & ~(std::uint64_t) 3;
+    }
+}
+
+// FNV-1a over the bytes of everything the cached meshes depend on
+class cache_key {
+public:
+    cache_key& add(const void* data, std::size_t size) {
+        const unsigned char* bytes = (const unsigned char*) data;
+        for(std::size_t i = 0; i < size; i++) {
+            value ^= bytes[i];
+            value *= 1099511628211ull;
+        }
+        return *this;
+    }
+
+    cache_key& add(const std::string& text) {
+        addValue((std::uint64_t) text.size());
+        return add(text.data(), text.size());
+    }
+
+    // T has to be free of padding (numbers, Vector3, vec3)
+    template<typename T>
+    cache_key& add(const std::vector<T>& values) {
+        addValue((std::uint64_t) values.size());
+        return add(values.data(), values.size() * sizeof(T));
+    }
+
+    template<typename T>
+    cache_key& addValue(const T& v) {
+        return add(&v, sizeof(T));
+    }
+
+    std::uint64_t get() const {
+        return value;
+    }
+
+private:
+    std::uint64_t value = 14695981039346656037ull;
+};
+
+inline std::string trackCachePath(std::uint64_t key) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "track_%016llx.cache", (unsigned long long) key);
+    return name;
+}
+
+// writes the chunks as built by extrudeChunks, their meshes still need their cpu side buffers
+inline bool saveTrackCache(const std::string& path, std::uint64_t key, const std::vector<track_chunk>& chunks) {
+    using namespace trackcache;
+    if(!littleEndian()) return false;
+
+    std::vector<cache_chunk> chunkTable{};
+    std::vector<const Mesh*> meshes{};
+    for(const track_chunk& chunk: chunks) {
+        cache_chunk c{
+            { chunk.bounds.min.x, chunk.bounds.min.y, chunk.bounds.min.z },
+            { chunk.bounds.max.x, chunk.bounds.max.y, chunk.bounds.max.z },
+            { chunk.center.x, chunk.center.y, chunk.center.z }, chunk.radius,
+            chunk.firstEdgeLoop, chunk.lastEdgeLoop, (std::uint32_t) meshes.size(), (std::uint32_t) chunk.levels.size()
+        };
+        chunkTable.push_back(c);
+        for(const Model& level: chunk.levels) meshes.push_back(&level.meshes[0]);
+    }
+
+    // lay out the buffers behind the tables
+    std::uint64_t offset = sizeof(cache_header) + chunkTable.size() * sizeof(cache_chunk) + meshes.size() * sizeof(cache_mesh);
+    auto place = [&](const void* buffer, std::uint64_t size) -> std::uint64_t {
+        if(!buffer) return 0;
+        std::uint64_t at = aligned(offset);
+        offset = at + size;
+        return at;
+    };
+
+    std::vector<cache_mesh> meshTable{};
+    for(const Mesh* m: meshes) {
+        std::uint64_t vertexCount = m->vertexCount;
+        cache_mesh entry{ (std::uint32_t) m->vertexCount, (std::uint32_t) m->triangleCount };
+        entry.vertices = place(m->vertices, vertexCount * 3 * sizeof(float));
+        entry.normals = place(m->normals, vertexCount * 3 * sizeof(float));
+        entry.texcoords = place(m->texcoords, vertexCount * 2 * sizeof(float));
+        entry.tangents = place(m->tangents, vertexCount * 4 * sizeof(float));
+        entry.indices = place(m->indices, (std::uint64_t) m->triangleCount * 3 * sizeof(unsigned short));
+        if(!entry.vertices) return false;
+        meshTable.push_back(entry);
+    }
+
+    cache_header header{ { 'S', 'C', 'T', 'C' }, formatVersion, key, (std::uint32_t) chunkTable.size(), (std::uint32_t) meshTable.size(), aligned(offset) };
+
+    // written to a temporary file first, an interrupted save never leaves a half file under the real name
+    std::string temporaryPath{ path + ".tmp" };
+    {
+        std::ofstream out{ temporaryPath, std::ios::binary | std::ios::trunc };
+        if(!out) return false;
+
+        std::uint64_t written = 0;
+        auto write = [&](const void* data, std::uint64_t size, std::uint64_t at) {
+            static const char padding[4]{};
+            if(at > written) out.write(padding, at - written);
+            out.write((const char*) data, size);
+            written = at + size;
+        };
+
+        write(&header, sizeof(header), 0);
+        write(chunkTable.data(), chunkTable.size() * sizeof(cache_chunk), written);
+        write(meshTable.data(), meshTable.size() * sizeof(cache_mesh), written);
+        for(std::size_t i = 0; i < meshes.size(); i++) {
+            const Mesh& m{ *meshes[i] };
+            const cache_mesh& entry{ meshTable[i] };
+            std::uint64_t vertexCount = m.vertexCount;
+            if(entry.vertices) write(m.vertices, vertexCount * 3 * sizeof(float), entry.vertices);
+            if(entry.normals) write(m.normals, vertexCount * 3 * sizeof(float), entry.normals);
+            if(entry.texcoords) write(m.texcoords, vertexCount * 2 * sizeof(float), entry.texcoords);
+            if(entry.tangents) write(m.tangents, vertexCount * 4 * sizeof(float), entry.tangents);
+            if(entry.indices) write(m.indices, (std::uint64_t) m.triangleCount * 3 * sizeof(unsigned short), entry.indices);
+        }
+        write(nullptr, 0, header.fileSize);
+        if(!out) return false;
+    }
+
+    std::remove(path.c_str());
+    return std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+// on a hit chunks gets the cached chunks with uploaded meshes, on a miss it stays untouched
+inline bool loadTrackCache(const std::string& path, std::uint64_t key, std::vector<track_chunk>& chunks) {
+    using namespace trackcache;
+    if(!littleEndian()) return false;
+
+    mapped_file file{ path };
+    if(!file.isOpen() || file.size() < sizeof(cache_header)) return false;
+
+    cache_header header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if(std::memcmp(header.magic, "SCTC", 4) != 0 || header.version != formatVersion || header.key != key || header.fileSize != file.size()) return false;
+
+    std::uint64_t tablesEnd = sizeof(cache_header) + (std::uint64_t) header.chunkCount * sizeof(cache_chunk) + (std::uint64_t) header.meshCount * sizeof(cache_mesh);
+    if(tablesEnd > file.size()) return false;
+
+    const cache_chunk* chunkTable = (const cache_chunk*) (file.data() + sizeof(cache_header));
+    const cache_mesh* meshTable = (const cache_mesh*) (chunkTable + header.chunkCount);
+
+    auto inside = [&](std::uint64_t offset, std::uint64_t size) {
+        return offset == 0 || (offset % 4 == 0 && offset >= tablesEnd && offset + size <= file.size());
+    };
+    for(std::uint32_t i = 0; i < header.meshCount; i++) {
+        const cache_mesh& m{ meshTable[i] };
+        std::uint64_t vertexCount = m.vertexCount;
+        if(!m.vertices || !inside(m.vertices, vertexCount * 3 * sizeof(float)) || !inside(m.normals, vertexCount * 3 * sizeof(float))
+            || !inside(m.texcoords, vertexCount * 2 * sizeof(float)) || !inside(m.tangents, vertexCount * 4 * sizeof(float))
+            || !inside(m.indices, (std::uint64_t) m.triangleCount * 3 * sizeof(unsigned short))) return false;
+    }
+    for(std::uint32_t i = 0; i < header.chunkCount; i++) {
+        if(chunkTable[i].levelCount == 0 || (std::uint64_t) chunkTable[i].firstMesh + chunkTable[i].levelCount > header.meshCount) return false;
+    }
+
+    auto buffer = [&](std::uint64_t offset) {
+        return offset? (void*) (file.data() + offset): nullptr;
+    };
+
+    std::vector<track_chunk> loaded{};
+    for(std::uint32_t i = 0; i < header.chunkCount; i++) {
+        const cache_chunk& c{ chunkTable[i] };
+        track_chunk chunk{};
+        chunk.bounds = BoundingBox{ { c.boundsMin[0], c.boundsMin[1], c.boundsMin[2] }, { c.boundsMax[0], c.boundsMax[1], c.boundsMax[2] } };
+        chunk.center = Vector3{ c.center[0], c.center[1], c.center[2] };
+        chunk.radius = c.radius;
+        chunk.firstEdgeLoop = c.firstEdgeLoop;
+        chunk.lastEdgeLoop = c.lastEdgeLoop;
+
+        for(std::uint32_t level = 0; level < c.levelCount; level++) {
+            const cache_mesh& entry{ meshTable[c.firstMesh + level] };
+            Mesh mesh{ 0 };
+            mesh.vertexCount = entry.vertexCount;
+            mesh.triangleCount = entry.triangleCount;
+            mesh.vertices = (float*) buffer(entry.vertices);
+            mesh.normals = (float*) buffer(entry.normals);
+            mesh.texcoords = (float*) buffer(entry.texcoords);
+            mesh.tangents = (float*) buffer(entry.tangents);
+            if(entry.indices) {
+                unsigned int indexBytes = entry.triangleCount * 3 * sizeof(unsigned short);
+                mesh.indices = (unsigned short*) MemAlloc(indexBytes);
+                std::memcpy(mesh.indices, buffer(entry.indices), indexBytes);
+            }
+            UploadMesh(&mesh, false);
+
+            // the mapping goes away with this function and UnloadMesh must not free it, the indices stay
+            mesh.vertices = mesh.normals = mesh.texcoords = mesh.tangents = nullptr;
+            chunk.levels.push_back(LoadModelFromMesh(mesh));
+        }
+        loaded.push_back(chunk);
+    }
+
+    chunks = std::move(loaded);
+    return true;
+}
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef TRACKCHUNKS_H
+#define TRACKCHUNKS_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "raylib.h"
+#include "point.h"
+#include "extrude.h"
+#include "frustum.h"
+
+// one piece of a chunked track with its bounds in world coordinates
+struct track_chunk {
+    std::vector<Model> levels;  //levels[0] has every edgeloop, every next level half as many
+    BoundingBox bounds;
+    Vector3 center;         //bounding sphere around the vertices
+    float radius;
+    int firstEdgeLoop;      //index into the edgeloop frames the chunk was extruded from
+    int lastEdgeLoop;
+};
+
+struct chunk_draw_stats {
+    int drawn = 0;
+    int culled = 0;
+    int triangles = 0;
+};
+
+// the lower levels use a subset of the edgeloops of level 0, so its bounds hold for all of them
+inline void computeChunkBounds(track_chunk& chunk) {
+    const Mesh& mesh{ chunk.levels[0].meshes[0] };
+    BoundingBox box{ { INFINITY, INFINITY, INFINITY }, { -INFINITY, -INFINITY, -INFINITY } };
+    for(int i = 0; i < mesh.vertexCount; i++) {
+        const float* v = mesh.vertices + i * 3;
+        box.min = Vector3{ std::min(box.min.x, v[0]), std::min(box.min.y, v[1]), std::min(box.min.z, v[2]) };
+        box.max = Vector3{ std::max(box.max.x, v[0]), std::max(box.max.y, v[1]), std::max(box.max.z, v[2]) };
+    }
+
+    math::vec3f center{ (math::vec3f{ box.min } + math::vec3f{ box.max }) * 0.5f };
+    float radiusSquared = 0;
+    for(int i = 0; i < mesh.vertexCount; i++) {
+        const float* v = mesh.vertices + i * 3;
+        radiusSquared = std::max(radiusSquared, (math::vec3f{ v[0], v[1], v[2] } - center).lengthSquared());
+    }
+
+    chunk.bounds = box;
+    chunk.center = center.toVector3();
+    chunk.radius = std::sqrt(radiusSquared);
+}
+
+/*
+ * extrude() in pieces of about chunkLength track length (chord length between the edgeloops), each with its own mesh.
+ * Neighbouring chunks share their boundary edgeloop, so there is no gap between them, and the texcoords
+ * continue from one chunk to the next.
+ *
+ * Every chunk gets up to levelCount levels of detail. Level k keeps every 2^k-th edgeloop, but always the
+ * two boundary loops, so neighbouring chunks match at any combination of levels and do not crack.
+ * A level is only added while it has fewer edgeloops than the one before. The kept loops keep their
+ * texcoord u from the full track, so the texture does not slide when a chunk switches levels.
+ */
+template<typename T>
+std::vector<track_chunk> extrudeChunks(const std::vector<Vector3>& outline, const std::vector<basic_oriented_pose<T>>& edgeLoopFrames, float chunkLength, int levelCount = 3, vertex_attributes attributes = { true, true, false }) {
+    std::vector<track_chunk> chunks{};
+    int edgeLoops = edgeLoopFrames.size();
+    if(edgeLoops < 2) return chunks;
+
+    std::vector<float> distances{ edgeLoopDistances(edgeLoopFrames) };
+
+    int first = 0;
+    while(first < edgeLoops - 1) {
+        int last = first + 1;
+        while(last < edgeLoops - 1 && distances[last] - distances[first] < chunkLength) last++;
+
+        track_chunk chunk{};
+        std::vector<basic_oriented_pose<T>> frames{};
+        std::vector<float> frameDistances{};
+        int previousEdgeLoops = 0;
+        for(int level = 0, step = 1; level < std::max(1, levelCount); level++, step *= 2) {
+            frames.clear();
+            frameDistances.clear();
+            auto keep = [&](int i) {
+                frames.push_back(edgeLoopFrames[i]);
+                frameDistances.push_back(distances[i]);
+            };
+            for(int i = first; i < last; i += step) keep(i);
+            keep(last);
+
+            if((int) frames.size() == previousEdgeLoops) break;
+            previousEdgeLoops = frames.size();
+            chunk.levels.push_back(LoadModelFromMesh(extrude(outline, frames, frameDistances, attributes)));
+        }
+        chunk.firstEdgeLoop = first;
+        chunk.lastEdgeLoop = last;
+        computeChunkBounds(chunk);
+        chunks.push_back(chunk);
+
+        first = last;
+    }
+    return chunks;
+}
+
+// level 0 up to lodDistance from the camera, level 1 up to twice that, level 2 up to 4 times that and so on
+inline int chunkLevel(const track_chunk& chunk, Vector3 cameraPosition, float lodDistance) {
+    float distance = std::max(0.0f, (math::vec3f{ chunk.center } - math::vec3f{ cameraPosition }).length() - chunk.radius);
+
+    int level = 0;
+    for(float limit = lodDistance; distance > limit && level + 1 < (int) chunk.levels.size(); limit *= 2) level++;
+    return level;
+}
+
+// draws the chunks inside the view at the level of their distance, the sphere test rejects most chunks, the box test the rest
+inline chunk_draw_stats drawChunks(const std::vector<track_chunk>& chunks, const frustum& view, Vector3 cameraPosition, float lodDistance, Color color, Color wireColor) {
+    chunk_draw_stats stats{};
+    for(const track_chunk& chunk: chunks) {
+        if(!view.containsSphere(chunk.center, chunk.radius) || !view.intersectsBox(chunk.bounds)) {
+            stats.culled++;
+            continue;
+        }
+
+        int level = chunkLevel(chunk, cameraPosition, lodDistance);
+        const Model& model{ chunk.levels[level] };
+        DrawModel(model, Vector3{ 0.0f, 0.0f, 0.0f }, 1.0f, color);
+        DrawModelWires(model, Vector3{ 0.0f, 0.0f, 0.0f }, 1.0f, wireColor);
+
+        stats.drawn++;
+        stats.triangles += model.meshes[0].triangleCount;
+    }
+    return stats;
+}
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef TRACKEXPORT_H
+#define TRACKEXPORT_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "raylib.h"
+#include "point.h"
+#include "extrude.h"
+
+/*
+ * Writes an extruded track to Wavefront OBJ and binary glTF (.glb) without building a mesh first.
+ *
+ * Both exporters generate one edgeloop at a time with edgeloop_extruder and write it out before the
+ * next one, only the current loop lives in memory, so a track with millions of triangles costs no more
+ * than a short one. Nothing here touches raylib's gpu functions, the headless TrackBaker uses it too.
+ * The vertices have positions, normals and texcoords like extrude(), the triangles come from forEachLoopTriangle like extrudeIndices.
+ */
+
+// fwrite behind a fixed size buffer, the output of the exporters is many small writes
+class buffered_writer {
+public:
+    explicit buffered_writer(const std::string& path, std::size_t bufferSize = 1 << 16)
+    : file{ std::fopen(path.c_str(), "wb") }, buffer(bufferSize)
+    {}
+
+    ~buffered_writer() {
+        close();
+    }
+
+    buffered_writer(const buffered_writer&) = delete;
+    buffered_writer& operator=(const buffered_writer&) = delete;
+
+    bool isOpen() const {
+        return file != nullptr;
+    }
+
+    void write(const void* data, std::size_t size) {
+        if(used + size > buffer.size()) flush();
+        if(size > buffer.size()) {
+            if(file && std::fwrite(data, 1, size, file) != size) failed = true;
+            return;
+        }
+        std::memcpy(buffer.data() + used, data, size);
+        used += size;
+    }
+
+    // printf into the buffer, for the text formats
+    template<typename... Args>
+    void print(const char* format, Args... args) {
+        char line[256];
+        int length = std::snprintf(line, sizeof(line), format, args...);
+        if(length > 0) write(line, std::min((std::size_t) length, sizeof(line) - 1));
+    }
+
+    void flush() {
+        if(file && used > 0 && std::fwrite(buffer.data(), 1, used, file) != used) failed = true;
+        used = 0;
+    }
+
+    // false when anything could not be written
+    bool close() {
+        if(!file) return false;
+
+        flush();
+        if(std::fclose(file) != 0) failed = true;
+        file = nullptr;
+        return !failed;
+    }
+
+private:
+    std::FILE* file;
+    std::vector<char> buffer;
+    std::size_t used = 0;
+    bool failed = false;
+};
+
+/*
+ * Goes through the edgeloops in order and hands every loop to function(loop, vertices, normals, texcoords),
+ * the buffers hold the loop's getVertexCount() vertices and are reused for the next loop.
+ */
+template<typename T, typename Function>
+void forEachEdgeLoop(const std::vector<Vector3>& outline, const std::vector<basic_oriented_pose<T>>& edgeLoopFrames, Function function) {
+    edgeloop_extruder<T> extruder{ outline };
+    int vertsInShape = extruder.getVertexCount();
+
+    std::vector<float> vertices(vertsInShape * 3);
+    std::vector<float> normals(vertsInShape * 3);
+    std::vector<float> texcoords(vertsInShape * 2);
+    extrusion_buffers buffers{ vertices.data(), normals.data(), texcoords.data() };
+
+    float distance = 0;
+    for(int i = 0; i < (int) edgeLoopFrames.size(); i++) {
+        if(i > 0) distance += (float) (edgeLoopFrames[i].position - edgeLoopFrames[i - 1].position).length();
+        extruder.extrude(edgeLoopFrames[i], distance, 0, buffers);
+        function(i, vertices.data(), normals.data(), texcoords.data());
+    }
+}
+
+// the faces follow every edgeloop right away, OBJ allows them anywhere after their vertices
+template<typename T>
+bool exportObj(const std::string& path, const std::vector<Vector3>& outline, const std::vector<basic_oriented_pose<T>>& edgeLoopFrames) {
+    buffered_writer out{ path };
+    if(!out.isOpen()) return false;
+
+    int vertsInShape = outline.size();
+    out.print("# SplineCoaster track, %i edgeloops, %i triangles\n", (int) edgeLoopFrames.size(), extrudedTriangleCount(vertsInShape, edgeLoopFrames.size()));
+    out.print("o track\n");
+
+    forEachEdgeLoop(outline, edgeLoopFrames, [&](int loop, const float* vertices, const float* normals, const float* texcoords) {
+        for(int vi = 0; vi < vertsInShape; vi++) out.print("v %.6g %.6g %.6g\n", vertices[vi * 3], vertices[vi * 3 + 1], vertices[vi * 3 + 2]);
+        for(int vi = 0; vi < vertsInShape; vi++) out.print("vn %.6g %.6g %.6g\n", normals[vi * 3], normals[vi * 3 + 1], normals[vi * 3 + 2]);
+        for(int vi = 0; vi < vertsInShape; vi++) out.print("vt %.6g %.6g\n", texcoords[vi * 2], texcoords[vi * 2 + 1]);
+
+        // obj indices start at 1, position, texcoord and normal share the index
+        if(loop > 0) forEachLoopTriangle(vertsInShape, loop - 1, [&](int i1, int i2, int i3) {
+            out.print("f %i/%i/%i %i/%i/%i %i/%i/%i\n", i1 + 1, i1 + 1, i1 + 1, i2 + 1, i2 + 1, i2 + 1, i3 + 1, i3 + 1, i3 + 1);
+        });
+    });
+
+    return out.close();
+}
+
+/*
+ * Binary glTF 2.0 with one indexed mesh. The vertices are interleaved (position, normal, texcoord, 32 bytes)
+ * so they can be written loop by loop, the 32 bit indices follow them.
+ * The JSON chunk comes first and needs the bounds of the positions, so the edgeloops are generated twice:
+ * once for the bounds and once for the binary chunk. Both passes keep a single loop in memory.
+ */
+template<typename T>
+bool exportGlb(const std::string& path, const std::vector<Vector3>& outline, const std::vector<basic_oriented_pose<T>>& edgeLoopFrames) {
+    int vertsInShape = outline.size();
+    int edgeLoops = edgeLoopFrames.size();
+    std::uint64_t vertexCount = extrudedVertexCount(vertsInShape, edgeLoops);
+    std::uint64_t indexCount = (std::uint64_t) extrudedTriangleCount(vertsInShape, edgeLoops) * 3;
+    if(indexCount == 0) return false;
+
+    float boundsMin[3]{ INFINITY, INFINITY, INFINITY };
+    float boundsMax[3]{ -INFINITY, -INFINITY, -INFINITY };
+    forEachEdgeLoop(outline, edgeLoopFrames, [&](int, const float* vertices, const float*, const float*) {
+        for(int vi = 0; vi < vertsInShape; vi++) {
+            for(int c = 0; c < 3; c++) {
+                boundsMin[c] = std::min(boundsMin[c], vertices[vi * 3 + c]);
+                boundsMax[c] = std::max(boundsMax[c], vertices[vi * 3 + c]);
+            }
+        }
+    });
+
+    const std::uint64_t stride = 32;
+    std::uint64_t vertexBytes = vertexCount * stride;
+    std::uint64_t indexBytes = indexCount * 4;
+    std::uint64_t binaryBytes = vertexBytes + indexBytes;
+
+    char json[2048];
+    int jsonLength = std::snprintf(json, sizeof(json),
+        "{\"asset\":{\"version\":\"2.0\",\"generator\":\"SplineCoaster\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0,\"name\":\"track\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},\"indices\":3,\"mode\":4}]}],"
+        "\"buffers\":[{\"byteLength\":%llu}],"
+        "\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":%llu,\"byteStride\":%llu,\"target\":34962},"
+        "{\"buffer\":0,\"byteOffset\":%llu,\"byteLength\":%llu,\"target\":34963}],"
+        "\"accessors\":[{\"bufferView\":0,\"byteOffset\":0,\"componentType\":5126,\"count\":%llu,\"type\":\"VEC3\",\"min\":[%.9g,%.9g,%.9g],\"max\":[%.9g,%.9g,%.9g]},"
+        "{\"bufferView\":0,\"byteOffset\":12,\"componentType\":5126,\"count\":%llu,\"type\":\"VEC3\"},"
+        "{\"bufferView\":0,\"byteOffset\":24,\"componentType\":5126,\"count\":%llu,\"type\":\"VEC2\"},"
+        "{\"bufferView\":1,\"byteOffset\":0,\"componentType\":5125,\"count\":%llu,\"type\":\"SCALAR\"}]}",
+        (unsigned long long) binaryBytes, (unsigned long long) vertexBytes, (unsigned long long) stride,
+        (unsigned long long) vertexBytes, (unsigned long long) indexBytes,
+        (unsigned long long) vertexCount, boundsMin[0], boundsMin[1], boundsMin[2], boundsMax[0], boundsMax[1], boundsMax[2],
+        (unsigned long long) vertexCount, (unsigned long long) vertexCount, (unsigned long long) indexCount);
+    if(jsonLength <= 0 || jsonLength >= (int) sizeof(json)) return false;
+
+    // chunks are padded to 4 bytes, json with spaces
+    std::uint32_t jsonChunkLength = (jsonLength + 3) & ~3;
+    std::uint32_t binaryChunkLength = (std::uint32_t) binaryBytes;      //already a multiple of 4
+    std::uint64_t totalLength = 12 + 8 + (std::uint64_t) jsonChunkLength + 8 + binaryChunkLength;
+    if(totalLength > UINT32_MAX) return false;
+
+    buffered_writer out{ path };
+    if(!out.isOpen()) return false;
+
+    auto writeUint32 = [&](std::uint32_t value) {
+        unsigned char bytes[4]{ (unsigned char) value, (unsigned char) (value >> 8), (unsigned char) (value >> 16), (unsigned char) (value >> 24) };
+        out.write(bytes, 4);
+    };
+    auto writeFloat = [&](float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, 4);
+        writeUint32(bits);
+    };
+
+    writeUint32(0x46546C67);    //"glTF"
+    writeUint32(2);
+    writeUint32((std::uint32_t) totalLength);
+
+    writeUint32(jsonChunkLength);
+    writeUint32(0x4E4F534A);    //"JSON"
+    out.write(json, jsonLength);
+    for(int i = jsonLength; i < (int) jsonChunkLength; i++) out.write(" ", 1);
+
+    writeUint32(binaryChunkLength);
+    writeUint32(0x004E4942);    //"BIN\0"
+    forEachEdgeLoop(outline, edgeLoopFrames, [&](int, const float* vertices, const float* normals, const float* texcoords) {
+        for(int vi = 0; vi < vertsInShape; vi++) {
+            for(int c = 0; c < 3; c++) writeFloat(vertices[vi * 3 + c]);
+            for(int c = 0; c < 3; c++) writeFloat(normals[vi * 3 + c]);
+            for(int c = 0; c < 2; c++) writeFloat(texcoords[vi * 2 + c]);
+        }
+    });
+    for(int loop = 0; loop < edgeLoops - 1; loop++) {
+        forEachLoopTriangle(vertsInShape, loop, [&](int i1, int i2, int i3) {
+            writeUint32(i1);
+            writeUint32(i2);
+            writeUint32(i3);
+        });
+    }
+
+    return out.close();
+}
+
+#endif
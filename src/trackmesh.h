@@ -0,0 +1,161 @@
+#ifndef TRACKMESH_H
+#define TRACKMESH_H
+
+#include <vector>
+#include <algorithm>
+
+#include "raylib.h"
+#include "point.h"
+#include "meshbuilder.h"
+#include "extrude.h"
+#include "math/splines/frametable.h"
+
+/*
+ * The extruded track of an editable spline, one edgeloop per sample of a frame table.
+ * Same vertices, attributes and triangles as extrude() on those samples.
+ *
+ * Unlike extrude() the loops are fixed to the table samples, so after an edit every vertex keeps
+ * its place in the buffers and update() only re-extrudes the loops of the changed segments and
+ * uploads them with UpdateMeshBuffer:
+ *
+ *  std::vector<math::segment_range> changed{ spline.setControlPoint(3, p) };
+ *  frames.update(changed);
+ *  track.update(changed);
+ *
+ * Texcoord u of the rebuilt loops is their chord length again, stretched so the last loop of a range
+ * keeps its u, like frame_table::update unwinds the twist. The loops after the range are not touched.
+ *
+ * Indexed while the vertices fit raylib's 16 bit indices. Longer tracks are triangle soup, then the
+ * loops are also kept on the cpu and update() expands the triangles next to the rebuilt loops.
+ */
+template<typename T>
+class track_mesh {
+public:
+    track_mesh(const std::vector<Vector3>& outline, const math::basic_frame_table<T>& inFrames, vertex_attributes attributes = { true, true, false })
+    : frames{ &inFrames }, extruder{ outline }
+    {
+        vertsInShape = extruder.getVertexCount();
+        edgeLoops = inFrames.getSampleCount();
+        int vertexCount = extrudedVertexCount(vertsInShape, edgeLoops);
+        int triangles = extrudedTriangleCount(vertsInShape, edgeLoops);
+
+        std::vector<basic_oriented_pose<T>> samples{};
+        samples.reserve(edgeLoops);
+        for(int i = 0; i < edgeLoops; i++) samples.push_back(inFrames.getSample(i));
+        distances = edgeLoopDistances(samples);
+
+        if(vertexCount <= meshbuilder::maxIndexedVertices) {
+            meshbuilder builder{ vertexCount, triangles, attributes };
+            loops = extrusion_buffers{ builder.getVertices(), builder.getNormals(), builder.getTexcoords(), builder.getTangents() };
+            extrudeVertices(outline, samples, distances, loops);
+            extrudeIndices(vertsInShape, edgeLoops, builder.getIndices());
+            mesh = builder.build(true);
+            return;
+        }
+
+        loopVertices.resize(vertexCount * 3);
+        loopNormals.resize(attributes.normals? vertexCount * 3: 0);
+        loopTexcoords.resize(attributes.texcoords? vertexCount * 2: 0);
+        loopTangents.resize(attributes.tangents? vertexCount * 4: 0);
+        loops = extrusion_buffers{ loopVertices.data(), attributes.normals? loopNormals.data(): nullptr,
+            attributes.texcoords? loopTexcoords.data(): nullptr, attributes.tangents? loopTangents.data(): nullptr };
+        extrudeVertices(outline, samples, distances, loops);
+
+        meshbuilder builder{ triangles, attributes };
+        expand(extrusion_buffers{ builder.getVertices(), builder.getNormals(), builder.getTexcoords(), builder.getTangents() }, 0, edgeLoops - 2);
+        mesh = builder.build(true);
+    }
+
+    // the buffers point into the mesh (indexed) or belong to this object (soup)
+    track_mesh(const track_mesh&) = delete;
+    track_mesh& operator=(const track_mesh&) = delete;
+
+    const Mesh& getMesh() const {
+        return mesh;
+    }
+
+    bool isIndexed() const {
+        return mesh.indices != nullptr;
+    }
+
+    // call after frame_table::update with the same ranges
+    void update(const std::vector<math::segment_range>& ranges) {
+        int samplesPerSegment = frames->getSamplesPerSegment();
+
+        for(const math::segment_range& range: ranges) {
+            int firstLoop = std::max(0, range.first * samplesPerSegment);
+            int lastLoop = std::min(range.last * samplesPerSegment, edgeLoops - 1);
+            if(firstLoop >= lastLoop) continue;
+
+            updateDistances(firstLoop, lastLoop);
+            for(int loop = firstLoop; loop <= lastLoop; loop++) extruder.extrude(frames->getSample(loop), distances[loop], loop * vertsInShape, loops);
+
+            if(isIndexed()) {
+                meshbuilder::updateVertices(mesh, firstLoop * vertsInShape, (lastLoop - firstLoop + 1) * vertsInShape);
+                continue;
+            }
+
+            // the loop pairs that touch one of the rebuilt loops
+            int firstPair = std::max(0, firstLoop - 1);
+            int lastPair = std::min(lastLoop, edgeLoops - 2);
+            expand(extrusion_buffers{ mesh.vertices, mesh.normals, mesh.texcoords, mesh.tangents }, firstPair, lastPair);
+            meshbuilder::updateVertices(mesh, firstPair * cornersPerLoopPair(), (lastPair - firstPair + 1) * cornersPerLoopPair());
+        }
+    }
+
+private:
+    const math::basic_frame_table<T>* frames;
+    edgeloop_extruder<T> extruder;
+    int vertsInShape = 0;
+    int edgeLoops = 0;
+
+    std::vector<float> distances{};     //texcoord u of every loop
+    extrusion_buffers loops{};          //vertex vi of loop i at i * vertsInShape + vi
+    std::vector<float> loopVertices{};  //soup only, the loops before expand
+    std::vector<float> loopNormals{};
+    std::vector<float> loopTexcoords{};
+    std::vector<float> loopTangents{};
+    Mesh mesh{};
+
+    int cornersPerLoopPair() const {
+        return (vertsInShape - 1) * 2 * 3;
+    }
+
+    void updateDistances(int firstLoop, int lastLoop) {
+        float oldEnd = distances[lastLoop];
+        for(int i = firstLoop + 1; i <= lastLoop; i++) {
+            distances[i] = distances[i - 1] + (float) (frames->getSample(i).position - frames->getSample(i - 1).position).length();
+        }
+        if(lastLoop == edgeLoops - 1) return;
+
+        float start = distances[firstLoop];
+        float length = distances[lastLoop] - start;
+        if(length <= 0) return;
+
+        float scale = (oldEnd - start) / length;
+        for(int i = firstLoop + 1; i < lastLoop; i++) distances[i] = start + (distances[i] - start) * scale;
+        distances[lastLoop] = oldEnd;
+    }
+
+    // copies the loops to the corners of the triangles between loop firstPair and lastPair + 1
+    void expand(const extrusion_buffers& soup, int firstPair, int lastPair) const {
+        auto copy = [](const float* source, float* target, int from, int to, int size) {
+            if(source && target) std::copy_n(source + from * size, size, target + to * size);
+        };
+
+        for(int pair = firstPair; pair <= lastPair; pair++) {
+            int corner = pair * cornersPerLoopPair();
+            forEachLoopTriangle(vertsInShape, pair, [&](int i1, int i2, int i3) {
+                for(int i: { i1, i2, i3 }) {
+                    copy(loops.vertices, soup.vertices, i, corner, 3);
+                    copy(loops.normals, soup.normals, i, corner, 3);
+                    copy(loops.texcoords, soup.texcoords, i, corner, 2);
+                    copy(loops.tangents, soup.tangents, i, corner, 4);
+                    corner++;
+                }
+            });
+        }
+    }
+};
+
+#endif